@@ -0,0 +1,159 @@
+#include "ChunkAdjacency.hpp"
+#include <fstream>
+#include <algorithm>
+
+static const char ADJACENCY_MAGIC[4] = {'H', 'D', 'N', 'A'};
+static const uint32_t ADJACENCY_VERSION = 1;
+
+// triangles whose corners are all within this fraction of the chunk's size of a plane lie on it
+static const float CAP_DISTANCE_FRACTION = 0.0001f;
+// and must be parallel to it to within this
+static const float CAP_MIN_ALIGNMENT = 0.999f;
+
+template<typename T>
+static void writeArray( std::ofstream& out, const std::vector<T>& values ) {
+	if( !values.empty() ) {
+		out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+	}
+}
+
+ChunkAdjacency::ChunkAdjacency() {
+}
+
+void ChunkAdjacency::clear() {
+	std::lock_guard<std::mutex> lk(_mutex);
+	_pairs.clear();
+}
+
+void ChunkAdjacency::addChunk( int id, const Cell& cell, const Model& chunk ) {
+	// only planes with a cell across them can have contacts
+	std::vector<int> neighborPlanes;
+	for( unsigned int i = 0; i < cell.getPlaneCount(); ++i ) {
+		const int neighborId = cell.getPlanes()[i].neighborId;
+		if( neighborId >= 0 && neighborId != id ) {
+			neighborPlanes.push_back(static_cast<int>(i));
+		}
+	}
+	if( neighborPlanes.empty() ) {
+		return;
+	}
+
+	const BoundingBox bbox = chunk.computeBoundingBox();
+	const cc::Vec3f& halfExtents = bbox.getHalfExtents();
+	const float tolerance = CAP_DISTANCE_FRACTION * 2.0f * std::max<float>(halfExtents.x, std::max<float>(halfExtents.y, halfExtents.z));
+
+	// sum each cap's triangles by the plane they lie on.  the last matched plane is tried first, as caps' triangles are contiguous.
+	std::vector<CapSum> caps(neighborPlanes.size());
+	const std::vector<Vertex>& vertices = chunk.getVertices();
+	const std::vector<int>& indices = chunk.getIndices();
+	size_t lastMatch = 0;
+	for( size_t t = 0; t + 2 < indices.size(); t += 3 ) {
+		const cc::Vec3f& a = vertices[indices[t]].position;
+		const cc::Vec3f& b = vertices[indices[t+1]].position;
+		const cc::Vec3f& c = vertices[indices[t+2]].position;
+		const cc::Vec3f cross = (b - a).cross(c - a);
+		const float doubleArea = cross.magnitude();
+		if( doubleArea <= 0.0f ) {
+			continue;
+		}
+		const cc::Vec3f normal = cross * (1.0f / doubleArea);
+		for( size_t n = 0; n < neighborPlanes.size(); ++n ) {
+			const size_t p = (lastMatch + n) % neighborPlanes.size();
+			const Plane& plane = cell.getPlanes()[neighborPlanes[p]];
+			if( fabsf(normal.dot(plane.normal)) < CAP_MIN_ALIGNMENT ) {
+				continue;
+			}
+			if( plane.unsignedDistance(a) > tolerance || plane.unsignedDistance(b) > tolerance || plane.unsignedDistance(c) > tolerance ) {
+				continue;
+			}
+			const float area = 0.5f * doubleArea;
+			caps[p].area += area;
+			caps[p].weightedCentroid += (a + b + c) * (area / 3.0f);
+			lastMatch = p;
+			break;
+		}
+	}
+
+	std::lock_guard<std::mutex> lk(_mutex);
+	for( size_t p = 0; p < neighborPlanes.size(); ++p ) {
+		if( caps[p].area <= 0.0f ) {
+			continue;
+		}
+		const int neighborId = cell.getPlanes()[neighborPlanes[p]].neighborId;
+		const std::pair<int, int> key(std::min<int>(id, neighborId), std::max<int>(id, neighborId));
+		CapSum& sum = _pairs[key].caps[(id == key.first) ? 0 : 1];
+		sum.area += caps[p].area;
+		sum.weightedCentroid += caps[p].weightedCentroid;
+	}
+}
+
+std::vector<ChunkAdjacency::Contact> ChunkAdjacency::getContacts() const {
+	std::lock_guard<std::mutex> lk(_mutex);
+	std::vector<Contact> contacts;
+	contacts.reserve(_pairs.size());
+	for( const auto& entry : _pairs ) {
+		// a cap on only one side is where the neighbor's chunk was not cut (or not kept), so the chunks do not touch
+		const CapSum& first = entry.second.caps[0];
+		const CapSum& second = entry.second.caps[1];
+		if( first.area <= 0.0f || second.area <= 0.0f ) {
+			continue;
+		}
+		Contact contact;
+		contact.firstId = entry.first.first;
+		contact.secondId = entry.first.second;
+		contact.area = 0.5f * (first.area + second.area);
+		contact.centroid = (first.weightedCentroid + second.weightedCentroid) * (1.0f / (first.area + second.area));
+		contacts.push_back(contact);
+	}
+	return contacts;
+}
+
+bool ChunkAdjacency::save( const std::string& path, const std::map<int, std::string>& names ) const {
+	// chunks are stored in id order, and contacts refer to them by index
+	std::vector<ChunkRecord> chunks;
+	std::vector<char> nameBytes;
+	std::map<int, uint32_t> chunkIndices;
+	for( const auto& entry : names ) {
+		ChunkRecord record;
+		record.cellId = entry.first;
+		record.nameOffset = static_cast<uint32_t>(nameBytes.size());
+		record.nameLength = static_cast<uint32_t>(entry.second.size());
+		nameBytes.insert(nameBytes.end(), entry.second.begin(), entry.second.end());
+		chunkIndices[entry.first] = static_cast<uint32_t>(chunks.size());
+		chunks.push_back(record);
+	}
+
+	std::vector<ContactRecord> contactRecords;
+	for( const auto& contact : getContacts() ) {
+		const auto first = chunkIndices.find(contact.firstId);
+		const auto second = chunkIndices.find(contact.secondId);
+		if( first == chunkIndices.end() || second == chunkIndices.end() ) {
+			continue;
+		}
+		ContactRecord record;
+		record.firstChunk = first->second;
+		record.secondChunk = second->second;
+		record.area = contact.area;
+		record.centroid[0] = contact.centroid.x;
+		record.centroid[1] = contact.centroid.y;
+		record.centroid[2] = contact.centroid.z;
+		contactRecords.push_back(record);
+	}
+
+	Header header;
+	std::copy(ADJACENCY_MAGIC, ADJACENCY_MAGIC + 4, header.magic);
+	header.version = ADJACENCY_VERSION;
+	header.chunkCount = static_cast<uint32_t>(chunks.size());
+	header.contactCount = static_cast<uint32_t>(contactRecords.size());
+	header.nameByteCount = static_cast<uint32_t>(nameBytes.size());
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if( !out.is_open() ) {
+		return false;
+	}
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	writeArray(out, chunks);
+	writeArray(out, contactRecords);
+	writeArray(out, nameBytes);
+	return out.good();
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef __chunk_adjacency__
+#define __chunk_adjacency__
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdint>
+#include <cc/Vec3.hpp>
+#include "Model.hpp"
+#include "cells/Cell.hpp"
+
+// which chunks touch and by how much, measured from the caps that slicing left on each chunk.  a cap lies on one of its
+// cell's planes, and the plane knows the cell across it, so contacts are found per chunk without testing pairs of chunks.
+// graphs are written as a compact (little endian) binary file:
+//    Header
+//    ChunkRecord[chunkCount]
+//    ContactRecord[contactCount]
+//    char[nameByteCount]        chunk names, not null terminated
+class ChunkAdjacency {
+public:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t chunkCount;
+		uint32_t contactCount;
+		uint32_t nameByteCount;
+	};
+
+	struct ChunkRecord {
+		int32_t cellId;
+		uint32_t nameOffset;
+		uint32_t nameLength;
+	};
+
+	struct ContactRecord {
+		uint32_t firstChunk; // index into the chunk records
+		uint32_t secondChunk;
+		float area;
+		float centroid[3];
+	};
+
+	struct Contact {
+		int firstId; // cell id of one chunk; always less than secondId
+		int secondId;
+		float area;
+		cc::Vec3f centroid;
+	};
+
+public:
+	ChunkAdjacency();
+
+	void clear();
+
+	/**
+	 * Measures the caps of a chunk against each neighboring cell.  Safe to call from multiple threads.
+	 * @param[in] id    Id of the cell that the chunk was cut by.
+	 * @param[in] cell  Cell that the chunk was cut by.  Must have planes with their neighbor ids.
+	 * @param[in] chunk Chunk output by slicing.
+	 */
+	void addChunk( int id, const Cell& cell, const Model& chunk );
+
+	/**
+	 * Pairs of chunks that share caps, ordered by their ids.  A contact's area is the mean of its caps on either chunk.
+	 * @returns Contacts between chunks.
+	 */
+	std::vector<Contact> getContacts() const;
+
+	/**
+	 * Writes the graph.  Contacts with chunks that are not named are dropped.
+	 * @param[in] path  Path of the file to write.
+	 * @param[in] names Names of chunks by their cell ids.
+	 * @returns True upon success; false otherwise.
+	 */
+	bool save( const std::string& path, const std::map<int, std::string>& names ) const;
+
+private:
+	struct CapSum {
+		float area;
+		cc::Vec3f weightedCentroid;
+
+		CapSum()
+			: area(0.0f), weightedCentroid(0.0f, 0.0f, 0.0f) {
+		}
+	};
+
+	struct CapPair {
+		CapSum caps[2]; // on the chunk with the lower and the higher id
+	};
+
+private:
+	mutable std::mutex _mutex;
+	std::map<std::pair<int, int>, CapPair> _pairs;
+};
+
+#endif /* __chunk_adjacency__ */
\ No newline at end of file
@@ -6,13 +6,43 @@
  *
  * usage:
  *    [meshName/mn];           string;    Name of object to fracture.
- *    [fractureType/ft];       string;    Type of fracture.  Options: uniform bezier cluster test
+ *    [fractureType/ft];       string;    Type of fracture.  Options: uniform bezier cluster poisson surface test
  *    [uniformCount/uc];       uint;      Number of uniform points to generate.
  *    [primaryCount/pc];       uint;      Number of primary points to generate.
  *    [secondaryCount/sc];     uint;      Number of secondary points to generate.
  *    [separationDistance/sd]; double;    Distance to move chunks' vertices along their normals.
  *    [fluxPercent/flp];       double;    Percentage relative to the size of the object's bounding volume to flux points by.
  *    [point/pnt];             double x3; Source points.  Can be repeated.
+ *    [sampleCount/sam];       uint;      Number of points sampled along each bezier curve.  A curve with none is ignored.
+ *    [cullExterior/ce];       bool;      Drop sample points outside of the mesh and trim cells to planes hugging it.
+ *    [cellType/ct];           string;    Type of cells.  Options: voronoi (default) power slab grid brick hex radial
+ *    [radiusPercent/rp];      double;    Percentage of the bounding box's size that sample point radii reach in power cells.
+ *    [savePattern/sp];        string;    Saves a tileable cell pattern over the unit cube to a file instead of fracturing.
+ *    [pattern/pat];           string;    Fractures using a saved cell pattern instead of generating cells.
+ *    [patternTiles/pti];      uint;      Number of copies of the pattern spanning the object along each axis.
+ *    [patternRotation/pr];    double x3; Rotation of the pattern in degrees.
+ *    [session/ses];           bool;      Keeps chunks between runs on the same mesh and only regenerates (voronoi) and re-slices cells whose seeds or neighbors changed.
+ *    [depth/dep];             uint;      Number of times to fracture; each level fractures every chunk of the previous one with the same point and cell types.  Defaults to 1.
+ *    [levelCount/lc];         uint;      [uniformCount/uc] per chunk for each level after the first.  Can be repeated; the last repeats.
+ *    [cutPlane/cpl];          double x6; Point and normal of a plane for slab cells to be cut by, in order.  Can be repeated.  Implies slab cells.  Deeper levels split slabs at the median of uniform points.
+ *    [splitMesh/spm];         bool;      Splits the mesh itself in two by each slab plane, in parallel, rather than slicing a cell per slab.
+ *    [relaxIterations/ri];    uint;      Number of times to move each sample point to the centroid of its cell, evening out cell shapes.  Cluster, bezier, and surface points keep their density.
+ *    [minFaceArea/mfa];       double;    Merges cells' faces smaller than this percentage of the cell's surface area into the face nearest in angle before slicing.
+ *    [mergeAngle/mga];        double;    Merges cells' faces whose normals are within this many degrees before slicing.
+ *    [tileSeeds/tse];         uint;      Computes voronoi cells a tile at a time with around this many points per tile to bound memory.  0 (default) disables tiling.
+ *    [latticeCount/lct];      uint x3;   Number of grid, brick, or hex cells along each axis.  Hex prisms stand along z and ignore the y count.
+ *    [latticeJitter/ljt];     double;    Percentage of the lattice spacing to move and tilt the planes between grid, brick, or hex cells by.
+ *    [wedgeCount/wdc];        uint;      Number of cracks running out from the impact point of radial cells.  Defaults to 12.
+ *    [ringCount/rgc];         uint;      Number of rings crossing the cracks of radial cells.  Defaults to 6.
+ *    [ringGrowth/rgg];        double;    Ratio of each radial ring's width to the one inside of it.  Defaults to 1.4.
+ *    [radialJitter/rj];       double;    Percentage of the spacing to turn radial cracks and move radial rings by.
+ *    [adjacency/adj];         string;    Writes which chunks touch, with the area and centroid of each contact, to a binary file.  Not for slab, grid, brick, or hex cells.
+ *    [minSpacing/msp];        double;    Minimum distance between poisson points as a percentage of the bounding box's diagonal.
+ *    [blueNoiseTile/bnt];     string;    Copies poisson points from a precomputed tile file, generating it first if it does not exist.
+ *    [insideMesh/im];         bool;      Generates uniform, cluster, bezier, and poisson points inside of the mesh rather than its bounding box.
+ *    [crack/crk];             uint, uint, double; Adds a bezier crack from the next given number of [point/pnt]s, with its own samples and flux.  Can be repeated.
+ *    [surfaceDepth/sdp];      double;    Mean distance surface points are moved inward as a percentage of the bounding box's diagonal.  Defaults to 1.
+ *    [colorWeight/cwt];       bool;      Weights surface points by the brightness of the mesh's vertex colors.
  *
  * Uniform fracturing:
  *    hadan -mn pCube1 -ft uniform -uc 10
@@ -21,35 +51,55 @@
  *
  *    [uniformCount/uc] points are randomly generated within the object's bounding box.
  *
+ * Poisson fracturing:
+ *    hadan -mn pCube1 -ft poisson -uc 100 (-msp 5.0) (-bnt C:/tiles/blue.bin)
+ *    [uniformCount/uc] [minSpacing/msp] [blueNoiseTile/bnt]
+ *    Evenly spread (blue noise) points that are never closer than a minimum spacing, which avoids slivers.
+ *
+ *    Points fill the object's bounding box [minSpacing/msp] apart, or if it is not given, at whatever spacing gives around
+ *    [uniformCount/uc] points.  With [blueNoiseTile/bnt], copies of a saved tile of points are laid over the bounding box
+ *    instead, which is near instant for millions of points.  The tile is generated and saved to the path on first use.
+ *
  * Bezier fracturing:
- *    hadan -mn pCube1 -ft bezier -uc 10 -flp 15.0 (-pnt 0 0 0 -pnt 1 1 1...)
- *    [uniformCount/uc] [fluxPercent/flp] [point/pnt]
+ *    hadan -mn pCube1 -ft bezier -uc 10 -sam 20 -flp 15.0 (-pnt 0 0 0 -pnt 1 1 1...)
+ *    [uniformCount/uc] [sampleCount/sam] [fluxPercent/flp] [point/pnt]
  *    Simulates a propagating crack using a bezier curve and uniform points.
  *
  *    The generation differs based on the number of [point/pnt]s provided.  If four [point/pnt]s are given, they are assumed
- *    to make up a curve.  If two [point/pnt]s are given, they are assumed to the the start and end points respectively, and
+ *    to make up a curve (seven, ten, and so on make a path of joined curves, each sharing its start with the previous end).  If two [point/pnt]s are given, they are assumed to the the start and end points respectively, and
  *    the intermediate two are randomly generated within the object's bounding box.  If no [point/pnt]s are provided, then
  *    all four points are randomly generated.  The start and end are generated on the surface of the bounding box, and will
  *    attempt to space themselves [fluxPercent/flp] of the bounding box's total size apart.  If they reach the maximum iteration
  *    count, the last attempt its taken, regardless of the distance.  The two intermediate points are randomly generated as before.
- *    The curve is sampled to generated [CHANGEME] A FIXED NUMBER of points.  These points are then randomized with a distance of
+ *    Each curve of the path is sampled at [sampleCount/sam] points, evenly spaced along its length rather than in t.  These points are then randomized with a distance of
  *    [fluxPercent/flp] of the bounding box's size.  [uniformCount/uc] randomly generated points within the object's bounding box
  *    are also added for variety.
  *
+ *    Each [crack/crk] adds a crack taking its points from the next of the [point/pnt]s, in order, with its own sample count and
+ *    [fluxPercent/flp].  A crack given no points is randomly generated.  All cracks are sampled together into one set of points,
+ *    so a whole network of cracks is cut at once, e.g. hadan -mn pCube1 -ft bezier -crk 2 40 5 -crk 0 20 10 -pnt 0 0 0 -pnt 1 1 1
+ *
+ * Surface fracturing:
+ *    hadan -mn pCube1 -ft surface -uc 200 -sdp 2.0 (-cwt true)
+ *    [uniformCount/uc] [surfaceDepth/sdp] [colorWeight/cwt]
+ *    Generates [uniformCount/uc] points near the surface of the mesh, where impacts and cracks start, so that fewer points are
+ *    needed for the same visible detail.  Each point lands on a triangle picked by its area (times the brightness of its
+ *    vertex colors with [colorWeight/cwt], so that density can be painted) and is moved inward by a random depth, most of them
+ *    shallow, averaging [surfaceDepth/sdp] of the bounding box's diagonal.
+ *
  * Cluster fracturing:
  *    hadan -mn pCube1 -ft cluster -uc 10 -pc 5 -sc 20 -flp 10.0 (-pnt 0 0 0 -pnt 1 1 1...)
  *    [uniformCount/uc] [primaryCount/pc] [secondaryCount/sc] [fluxPercent/flp] [point/pnt]
  *    A set of primary points are used to source local clusters of secondary points, with a sprinkle of uniform on top.
  *
  *    User-provided [point/pnt]s are appended with [primaryCount/pc] randomly generated points within the object's bounding box.
- *    For each of these points, [secondaryCount/sc] points are generated around it.  The distance from the original point is
+ *    For each of these points, [secondaryCount/sc] points are generated normally distributed around it.  Their spread is
  *    controlled by [fluxPercent/flp], which is a percentage of the total size of the object's bounding box.
  *    [uniformCount/uc] randomly generated points within the object's bounding box are also added to increase variation.
  */
 
 // todo:
 //    - expose minimum distance, as it is hardcoded inside bezier
-//    - expose number of samples of bezier curve (currently hardcoded)
 //    - fix plane in world space drawing position bug
 //    - preserve UVs and somehow add a separate material on the inside
 //    - add generated pieces to a group
@@ -64,10 +114,16 @@
 #include "points/PointGenInfo.hpp"
 #include "Model.hpp"
 #include "cells/Cell.hpp"
+#include "cells/CellGenInfo.hpp"
+#include "cells/CellGenFactory.hpp"
 #include "slicing/IMeshSlicer.hpp"
 #include <mutex>
+#include <atomic>
 #include "slicing/MeshSlicerFactory.hpp"
 #include "slicing/MeshSlicerInfo.hpp"
+#include "HadanSession.hpp"
+#include "ChunkAdjacency.hpp"
+#include <map>
 
 class Hadan : public MPxCommand {
 public:
@@ -82,12 +138,26 @@ public:
 
 private:
 	bool parseArgs( const MArgList& args );
+	bool usesSamplePoints() const;
 	bool validateInputMesh() const;
 	void copyMeshFromMaya();
 	bool generateSamplePoints();
-	bool generateCuttingCells();
+	bool cullExterior();
+	bool relaxSamplePoints();
+	bool relaxPreservesDensity() const;
+	bool savePattern();
+	std::shared_ptr<IMeshSlicer> createSlicer();
+	bool generateAndCutCells( std::shared_ptr<IMeshSlicer> slicer );
+	bool generateAndCutCellsRecursively( std::shared_ptr<IMeshSlicer> slicer );
+	bool splitMeshIntoSlabs();
+	void createChunkMeshes( std::vector<Model>& chunks );
+	void fractureChunk( const Model& chunk, unsigned int level, unsigned int chunkIndex, std::vector<Model>& outChunks );
 	void doSingleCut( const Cell& cell, int id, std::shared_ptr<IMeshSlicer> slicer );
-	void performCutting();
+	void doSessionCut( const Cell& cell, int id, std::shared_ptr<IMeshSlicer> slicer );
+	bool selectSessionSeeds();
+	void saveAdjacency();
+	HadanSession::SeedKey sessionSeedKey( int id ) const;
+	std::string sessionFingerprint() const;
 	void centerAllPivots();
 	void applyMaterials();
 	void separateCells();
@@ -99,10 +169,30 @@ private:
 	double _separationDistance;
 	PointGenInfo _pointGenInfo;
 	std::vector<cc::Vec3f> _samplePoints;
-	std::vector<Cell> _cuttingCells;
+	std::atomic<size_t> _cuttingCellCount;
 	std::vector<MObject> _generatedMeshes;
 	BoundingBox _boundingBox;
 	bool _useMultithreading;
+	bool _cullExterior;
+	bool _insideMesh;
+	bool _useColorWeights;
+	CellGenFactory::Type _cellGenType;
+	std::string _savePatternPath;
+	bool _useSession;
+	HadanSession* _session;
+	std::map<HadanSession::SeedKey, HadanSession::CellRecord> _sessionCells;
+	std::vector<int> _sessionSeedIds; // sample point of each cell generated when only part of the diagram is (empty when all of it is)
+	std::vector<bool> _sessionRecut; // whether each of those cells is cut, rather than only there to bound the cells that are
+	std::atomic<size_t> _reusedChunkCount;
+	unsigned int _depth;
+	std::vector<unsigned int> _levelCounts;
+	unsigned int _relaxIterations;
+	bool _splitMesh;
+	std::string _adjacencyPath;
+	bool _useAdjacency;
+	ChunkAdjacency _adjacency;
+	std::map<int, MObject> _adjacencyChunks;
+	CellGenInfo _cellGenInfo;
 	MeshSlicerInfo _meshSlicerInfo;
 	MeshSlicerFactory::Type _slicerType;
 };
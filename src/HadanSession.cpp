@@ -0,0 +1,104 @@
+#include "HadanSession.hpp"
+#include <maya/MObjectHandle.h>
+#include <maya/MFnDagNode.h>
+#include <maya/MGlobal.h>
+
+static bool isChunkAlive( const MObject& chunk ) {
+	const MObjectHandle handle(chunk);
+	return handle.isValid() && handle.isAlive();
+}
+
+HadanSession::SeedKey::SeedKey()
+	: x(0.0f), y(0.0f), z(0.0f), radius(0.0f) {
+}
+
+HadanSession::SeedKey::SeedKey( float inX, float inY, float inZ, float inRadius )
+	: x(inX), y(inY), z(inZ), radius(inRadius) {
+}
+
+bool HadanSession::SeedKey::operator<( const SeedKey& rhs ) const {
+	if( x != rhs.x ) {
+		return x < rhs.x;
+	}
+	if( y != rhs.y ) {
+		return y < rhs.y;
+	}
+	if( z != rhs.z ) {
+		return z < rhs.z;
+	}
+	return radius < rhs.radius;
+}
+
+bool HadanSession::SeedKey::operator==( const SeedKey& rhs ) const {
+	return x == rhs.x && y == rhs.y && z == rhs.z && radius == rhs.radius;
+}
+
+HadanSession::CellRecord::CellRecord()
+	: hasChunk(false) {
+}
+
+bool HadanSession::CellRecord::sameShapeAs( const CellRecord& rhs ) const {
+	return neighbors == rhs.neighbors && walls == rhs.walls;
+}
+
+HadanSession::HadanSession() {
+}
+
+HadanSession& HadanSession::get( const std::string& meshPath ) {
+	static std::map<std::string, HadanSession> sessions;
+	auto iter = sessions.find(meshPath);
+	if( iter == sessions.end() ) {
+		iter = sessions.insert(std::make_pair(meshPath, HadanSession())).first;
+	}
+	return iter->second;
+}
+
+void HadanSession::validate( const std::string& fingerprint ) {
+	if( fingerprint != _fingerprint ) {
+		_cells.clear();
+		_group = MObject();
+		_fingerprint = fingerprint;
+	}
+}
+
+void HadanSession::pruneDeadChunks() {
+	for( auto iter = _cells.begin(); iter != _cells.end(); ) {
+		if( iter->second.hasChunk && !isChunkAlive(iter->second.chunk) ) {
+			iter = _cells.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+	if( !isChunkAlive(_group) ) {
+		_group = MObject();
+	}
+}
+
+const HadanSession::CellRecord* HadanSession::findCell( const SeedKey& seed ) const {
+	const auto iter = _cells.find(seed);
+	return (iter != _cells.end()) ? &iter->second : nullptr;
+}
+
+const std::map<HadanSession::SeedKey, HadanSession::CellRecord>& HadanSession::getCells() const {
+	return _cells;
+}
+
+void HadanSession::commit( std::map<SeedKey, CellRecord>& cells ) {
+	// delete previous chunks that the current run did not reuse
+	for( auto& entry : _cells ) {
+		if( !entry.second.hasChunk || !isChunkAlive(entry.second.chunk) ) {
+			continue;
+		}
+		const auto current = cells.find(entry.first);
+		if( current != cells.end() && current->second.hasChunk && current->second.chunk == entry.second.chunk ) {
+			continue;
+		}
+		MObject chunkXform = MFnDagNode(entry.second.chunk).parent(0);
+		MGlobal::deleteNode(chunkXform);
+	}
+	_cells.swap(cells);
+}
+
+MObject& HadanSession::getGroup() {
+	return _group;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#ifndef __hadan_session__
+#define __hadan_session__
+
+#include <map>
+#include <string>
+#include <vector>
+#include <maya/MObject.h>
+#include <cc/Vec3.hpp>
+
+// state kept between runs of hadan on the same mesh, so that a rerun after editing a few sample points only
+// regenerates and re-slices the cells that changed.  a cell is unchanged when its seed and the seeds across each of its faces are.
+class HadanSession {
+public:
+	// position and radius of a seed; seeds are matched between runs by exact value
+	struct SeedKey {
+		float x;
+		float y;
+		float z;
+		float radius;
+
+		SeedKey();
+		SeedKey( float inX, float inY, float inZ, float inRadius );
+		bool operator<( const SeedKey& rhs ) const;
+		bool operator==( const SeedKey& rhs ) const;
+	};
+
+	struct CellRecord {
+		std::vector<SeedKey> neighbors; // seeds across the cell's faces, sorted
+		std::vector<int> walls; // walls the cell touches, sorted
+		MObject chunk; // mesh cut out by the cell
+		bool hasChunk; // false if slicing the cell produced nothing
+		std::vector<cc::Vec3f> corners; // corners of the cell, to tell which cells a new seed cuts into
+
+		CellRecord();
+		bool sameShapeAs( const CellRecord& rhs ) const;
+	};
+
+public:
+	/**
+	 * Gets the session of a mesh, creating an empty one if needed.  Sessions live until the plugin is unloaded.
+	 * @param[in] meshPath Full path of the mesh.
+	 * @returns Session of the mesh.
+	 */
+	static HadanSession& get( const std::string& meshPath );
+
+	/**
+	 * Forgets all cells if the settings they were cut with differ from the given ones.
+	 * @param[in] fingerprint Description of every setting (other than sample points) that affects the result.
+	 */
+	void validate( const std::string& fingerprint );
+
+	/**
+	 * Forgets cells whose chunks no longer exist in the scene (for instance, deleted by the user).
+	 */
+	void pruneDeadChunks();
+
+	/**
+	 * Finds the cell of a seed from the previous run.
+	 * @param[in] seed Seed to look for.
+	 * @returns The cell if there is one; nullptr otherwise.
+	 */
+	const CellRecord* findCell( const SeedKey& seed ) const;
+
+	const std::map<SeedKey, CellRecord>& getCells() const;
+
+	/**
+	 * Replaces the cells of the previous run with those of the current run, deleting the chunks of previous cells that
+	 * were not carried over.
+	 * @param[in] cells Cells of the current run.
+	 */
+	void commit( std::map<SeedKey, CellRecord>& cells );
+
+	MObject& getGroup();
+
+private:
+	HadanSession();
+
+private:
+	std::string _fingerprint;
+	std::map<SeedKey, CellRecord> _cells;
+	MObject _group; // transform that the chunks are parented to
+};
+
+#endif /* __hadan_session__ */
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "MappedFile.hpp"
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <Windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+MappedFile::MappedFile()
+#if defined(_WIN32)
+	: _data(nullptr), _size(0), _file(INVALID_HANDLE_VALUE), _mapping(nullptr) {
+#else
+	: _data(nullptr), _size(0), _file(-1) {
+#endif
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+bool MappedFile::open( const std::string& path ) {
+	close();
+
+#if defined(_WIN32)
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, nullptr);
+	if( INVALID_HANDLE_VALUE == _file ) {
+		return false;
+	}
+	LARGE_INTEGER fileSize;
+	if( !GetFileSizeEx(_file, &fileSize) || 0 == fileSize.QuadPart ) {
+		close();
+		return false;
+	}
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if( nullptr == _mapping ) {
+		close();
+		return false;
+	}
+	_data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	_size = static_cast<size_t>(fileSize.QuadPart);
+#else
+	_file = ::open(path.c_str(), O_RDONLY);
+	if( -1 == _file ) {
+		return false;
+	}
+	struct stat fileStat;
+	if( fstat(_file, &fileStat) != 0 || 0 == fileStat.st_size ) {
+		close();
+		return false;
+	}
+	void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, _file, 0);
+	_data = (MAP_FAILED == data) ? nullptr : static_cast<const unsigned char*>(data);
+	_size = static_cast<size_t>(fileStat.st_size);
+#endif
+
+	if( nullptr == _data ) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close() {
+#if defined(_WIN32)
+	if( _data != nullptr ) {
+		UnmapViewOfFile(_data);
+	}
+	if( _mapping != nullptr ) {
+		CloseHandle(_mapping);
+		_mapping = nullptr;
+	}
+	if( _file != INVALID_HANDLE_VALUE ) {
+		CloseHandle(_file);
+		_file = INVALID_HANDLE_VALUE;
+	}
+#else
+	if( _data != nullptr ) {
+		munmap(const_cast<unsigned char*>(_data), _size);
+	}
+	if( _file != -1 ) {
+		::close(_file);
+		_file = -1;
+	}
+#endif
+	_data = nullptr;
+	_size = 0;
+}
+
+const unsigned char* MappedFile::getData() const {
+	return _data;
+}
+
+size_t MappedFile::getSize() const {
+	return _size;
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#ifndef __mapped_file__
+#define __mapped_file__
+
+#include <string>
+#include <cstddef>
+
+// read-only memory mapping of a whole file
+class MappedFile {
+public:
+	MappedFile();
+	MappedFile( const MappedFile& rhs )=delete;
+	MappedFile& operator=( const MappedFile& rhs )=delete;
+	~MappedFile();
+
+	/**
+	 * Maps a file into memory, unmapping any previously mapped file.
+	 * @param[in] path Path of the file to map.
+	 * @returns True upon success; false otherwise.
+	 */
+	bool open( const std::string& path );
+
+	/**
+	 * Unmaps the file, if any.
+	 */
+	void close();
+
+	const unsigned char* getData() const;
+	size_t getSize() const;
+
+private:
+	const unsigned char* _data; /**< Start of the mapped file. */
+	size_t _size; /**< Size of the mapped file in bytes. */
+#if defined(_WIN32)
+	void* _file; /**< Handle of the opened file. */
+	void* _mapping; /**< Handle of the file mapping. */
+#else
+	int _file; /**< Descriptor of the opened file. */
+#endif
+};
+
+#endif /* __mapped_file__ */
\ No newline at end of file
@@ -18,6 +18,8 @@
 #include <maya/MMatrix.h>
 #include <cc/TriMath.hpp>
 #include <maya/MItMeshFaceVertex.h>
+#include <maya/MColorArray.h>
+#include <vector>
 
 namespace MayaHelper {
 	static bool getObjectFromString( const std::string& path, MDagPath& outDagPath ) {
@@ -90,6 +92,28 @@ namespace MayaHelper {
 		}
 	}
 
+	// one weight per vertex from the brightness of its color, in the same order as copyMFnMeshToModel's vertices.
+	// unpainted vertices weigh nothing.  returns false if no vertex is painted.
+	static bool getVertexColorWeights( MDagPath& mayaMeshDagPath, std::vector<float>& outWeights ) {
+		MFnMesh mayaMesh(mayaMeshDagPath);
+		MColorArray colors;
+		if( mayaMesh.getVertexColors(colors) != MS::kSuccess ) {
+			return false;
+		}
+		bool anyPainted = false;
+		outWeights.resize(colors.length());
+		for( unsigned int i = 0; i < colors.length(); ++i ) {
+			const MColor& color = colors[i];
+			if( color.r < 0.0f ) {
+				outWeights[i] = 0.0f;
+				continue;
+			}
+			outWeights[i] = 0.2126f * color.r + 0.7152f * color.g + 0.0722f * color.b;
+			anyPainted = true;
+		}
+		return anyPainted;
+	}
+
 	static bool copyModelToMFnMesh( Model& model, MFnMesh& outMayaMesh, float smoothingAngle ) {
 		if( 0 == model.getVertices().size() || 0 == model.getIndices().size() ) {
 			return false;
@@ -0,0 +1,138 @@
+#include "MeshInsideTest.hpp"
+#include <algorithm>
+#include <functional>
+#include <cmath>
+
+// average number of triangles per cell that the grid is sized for
+static const float TRIANGLES_PER_CELL = 4.0f;
+
+// whether a point on an edge of a counterclockwise triangle belongs to it.  of two triangles sharing an edge, exactly one
+// sees it as a top or left edge, so points on the edge are counted once.
+static bool isTopLeft( float y0, float z0, float y1, float z1 ) {
+	const float dy = y1 - y0;
+	const float dz = z1 - z0;
+	return (dz < 0.0f) || (0.0f == dz && dy > 0.0f);
+}
+
+MeshInsideTest::MeshInsideTest()
+	: _resY(0), _resZ(0), _minY(0.0f), _minZ(0.0f), _cellSizeY(1.0f), _cellSizeZ(1.0f) {
+}
+
+bool MeshInsideTest::build( const Model& model ) {
+	_triangles.clear();
+	_cellStarts.clear();
+	_cellTriangles.clear();
+	_bbox = model.computeBoundingBox();
+
+	// keep triangles that cover any area across y and z, wound the same way
+	const std::vector<Vertex>& vertices = model.getVertices();
+	const std::vector<int>& indices = model.getIndices();
+	for( size_t i = 0; i + 2 < indices.size(); i += 3 ) {
+		const cc::Vec3f& a = vertices[indices[i]].position;
+		const cc::Vec3f& b = vertices[indices[i+1]].position;
+		const cc::Vec3f& c = vertices[indices[i+2]].position;
+		const float area = (b.y - a.y) * (c.z - a.z) - (b.z - a.z) * (c.y - a.y);
+		if( 0.0f == area ) {
+			continue;
+		}
+		Triangle triangle;
+		const cc::Vec3f* corners[3] = {&a, (area > 0.0f) ? &b : &c, (area > 0.0f) ? &c : &b};
+		for( int k = 0; k < 3; ++k ) {
+			triangle.y[k] = corners[k]->y;
+			triangle.z[k] = corners[k]->z;
+		}
+		triangle.normal = (b - a).cross(c - a);
+		triangle.corner = a;
+		_triangles.push_back(triangle);
+	}
+	if( _triangles.empty() ) {
+		return false;
+	}
+
+	// square-ish cells over the model's extents across y and z
+	const cc::Vec3f& center = _bbox.getCenter();
+	const cc::Vec3f& halfExtents = _bbox.getHalfExtents();
+	_minY = center.y - halfExtents.y;
+	_minZ = center.z - halfExtents.z;
+	const float sizeY = std::max<float>(halfExtents.y * 2.0f, std::numeric_limits<float>::epsilon());
+	const float sizeZ = std::max<float>(halfExtents.z * 2.0f, std::numeric_limits<float>::epsilon());
+	const float cellCount = std::max<float>(1.0f, static_cast<float>(_triangles.size()) / TRIANGLES_PER_CELL);
+	const float cellSize = sqrtf(sizeY * sizeZ / cellCount);
+	_resY = cc::math::clamp<int>(static_cast<int>(ceilf(sizeY / cellSize)), 1, 1024);
+	_resZ = cc::math::clamp<int>(static_cast<int>(ceilf(sizeZ / cellSize)), 1, 1024);
+	_cellSizeY = sizeY / static_cast<float>(_resY);
+	_cellSizeZ = sizeZ / static_cast<float>(_resZ);
+
+	// count then fill each cell's triangles, by the cells that the triangle's extents overlap
+	const auto forEachCell = [&]( const Triangle& triangle, const std::function<void( int cell )>& visit ) {
+		const int y0 = cellY(std::min<float>(triangle.y[0], std::min<float>(triangle.y[1], triangle.y[2])));
+		const int y1 = cellY(std::max<float>(triangle.y[0], std::max<float>(triangle.y[1], triangle.y[2])));
+		const int z0 = cellZ(std::min<float>(triangle.z[0], std::min<float>(triangle.z[1], triangle.z[2])));
+		const int z1 = cellZ(std::max<float>(triangle.z[0], std::max<float>(triangle.z[1], triangle.z[2])));
+		for( int z = z0; z <= z1; ++z ) {
+			for( int y = y0; y <= y1; ++y ) {
+				visit(y + _resY * z);
+			}
+		}
+	};
+	_cellStarts.assign(_resY * _resZ + 1, 0);
+	for( const auto& triangle : _triangles ) {
+		forEachCell(triangle, [&]( int cell ) {
+			++_cellStarts[cell + 1];
+		});
+	}
+	for( size_t cell = 1; cell < _cellStarts.size(); ++cell ) {
+		_cellStarts[cell] += _cellStarts[cell - 1];
+	}
+	_cellTriangles.resize(_cellStarts.back());
+	std::vector<int> fill(_cellStarts.begin(), _cellStarts.end() - 1);
+	for( size_t t = 0; t < _triangles.size(); ++t ) {
+		forEachCell(_triangles[t], [&]( int cell ) {
+			_cellTriangles[fill[cell]++] = static_cast<int>(t);
+		});
+	}
+	return true;
+}
+
+bool MeshInsideTest::contains( const cc::Vec3f& point ) const {
+	if( _triangles.empty() || point.x > _bbox.maxX() || point.y < _bbox.minY() || point.y > _bbox.maxY() || point.z < _bbox.minZ() || point.z > _bbox.maxZ() ) {
+		return false;
+	}
+
+	const int cell = cellY(point.y) + _resY * cellZ(point.z);
+	int crossings = 0;
+	for( int entry = _cellStarts[cell]; entry < _cellStarts[cell + 1]; ++entry ) {
+		const Triangle& triangle = _triangles[_cellTriangles[entry]];
+
+		// the point must be inside of the triangle across y and z, or on one of its top or left edges
+		bool isInside = true;
+		for( int k = 0; k < 3 && isInside; ++k ) {
+			const int next = (k + 1) % 3;
+			const float edge = (triangle.y[next] - triangle.y[k]) * (point.z - triangle.z[k]) - (triangle.z[next] - triangle.z[k]) * (point.y - triangle.y[k]);
+			isInside = (edge > 0.0f) || (0.0f == edge && isTopLeft(triangle.y[k], triangle.z[k], triangle.y[next], triangle.z[next]));
+		}
+		if( !isInside ) {
+			continue;
+		}
+
+		// and the triangle must be ahead of it along x
+		const cc::Vec3f& n = triangle.normal;
+		const float hitX = triangle.corner.x - (n.y * (point.y - triangle.corner.y) + n.z * (point.z - triangle.corner.z)) / n.x;
+		if( hitX > point.x ) {
+			++crossings;
+		}
+	}
+	return (crossings % 2) == 1;
+}
+
+const BoundingBox& MeshInsideTest::getBoundingBox() const {
+	return _bbox;
+}
+
+int MeshInsideTest::cellY( float y ) const {
+	return cc::math::clamp<int>(static_cast<int>((y - _minY) / _cellSizeY), 0, _resY - 1);
+}
+
+int MeshInsideTest::cellZ( float z ) const {
+	return cc::math::clamp<int>(static_cast<int>((z - _minZ) / _cellSizeZ), 0, _resZ - 1);
+}
\ No newline at end of file
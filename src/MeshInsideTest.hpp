@@ -0,0 +1,56 @@
+#ifndef __mesh_inside_test__
+#define __mesh_inside_test__
+
+#include <vector>
+#include <cc/Vec3.hpp>
+#include "Model.hpp"
+
+// tests whether points are inside of a closed mesh by counting the triangles crossed by a ray along +x.  triangles are binned
+// by their extents across y and z into a grid, so a point is only tested against the triangles in its cell rather than every
+// triangle as Model::containsPoint does.  a ray through a shared edge or vertex is counted for exactly one of the triangles
+// that share it, so axis-aligned geometry needs no skewed ray.
+class MeshInsideTest {
+public:
+	MeshInsideTest();
+
+	/**
+	 * Builds the test for a closed model.
+	 * @param[in] model Model to test against.  Must be closed.
+	 * @returns True if the model has any triangles; false otherwise.
+	 */
+	bool build( const Model& model );
+
+	/**
+	 * Tests if a point is inside of the model.  Safe to call from multiple threads once built.
+	 * @param[in] point Point to test.
+	 * @returns True if the point is inside; false otherwise.
+	 */
+	bool contains( const cc::Vec3f& point ) const;
+
+	const BoundingBox& getBoundingBox() const;
+
+private:
+	struct Triangle {
+		float y[3]; // corners across y and z, wound counterclockwise
+		float z[3];
+		cc::Vec3f normal;
+		cc::Vec3f corner;
+	};
+
+	int cellY( float y ) const;
+	int cellZ( float z ) const;
+
+private:
+	std::vector<Triangle> _triangles;
+	std::vector<int> _cellStarts; // first entry of each cell in _cellTriangles, plus one past the end
+	std::vector<int> _cellTriangles;
+	int _resY;
+	int _resZ;
+	float _minY;
+	float _minZ;
+	float _cellSizeY;
+	float _cellSizeZ;
+	BoundingBox _bbox;
+};
+
+#endif /* __mesh_inside_test__ */
\ No newline at end of file
@@ -171,10 +171,8 @@ BoundingBox Model::computeBoundingBox() const {
 	}
 	cc::Vec3f min(std::numeric_limits<float>::max());
 	cc::Vec3f max(-std::numeric_limits<float>::max());
-	cc::Vec3f center;
 	for( size_t i = 0; i < _vertices.size(); ++i ) {
 		const cc::Vec3f& pos = _vertices[i].position;
-		center += pos;
 		min.x = (pos.x < min.x) ? pos.x : min.x;
 		min.y = (pos.y < min.y) ? pos.y : min.y;
 		min.z = (pos.z < min.z) ? pos.z : min.z;
@@ -182,11 +180,45 @@ BoundingBox Model::computeBoundingBox() const {
 		max.y = (pos.y > max.y) ? pos.y : max.y;
 		max.z = (pos.z > max.z) ? pos.z : max.z;
 	}
-	center /= static_cast<float>(_vertices.size());
+	// center of the box rather than the average vertex, which is skewed toward densely tessellated areas
+	const cc::Vec3f center = (min + max) * 0.5f;
 	const cc::Vec3f halfExtents = (max - min) * 0.5f;
 	return BoundingBox(center, halfExtents);
 }
 
+bool Model::containsPoint( const cc::Vec3f& point ) const {
+	// skewed direction so that the ray is unlikely to graze edges of axis-aligned geometry
+	const cc::Vec3f dir = cc::Vec3f(1.0f, 0.0013f, 0.0021f).normalized();
+
+	int crossings = 0;
+	for( size_t i = 0; i + 2 < _indices.size(); i += 3 ) {
+		// moller-trumbore
+		const cc::Vec3f& v0 = _vertices[_indices[i]].position;
+		const cc::Vec3f e1 = _vertices[_indices[i+1]].position - v0;
+		const cc::Vec3f e2 = _vertices[_indices[i+2]].position - v0;
+		const cc::Vec3f p = dir.cross(e2);
+		const float det = e1.dot(p);
+		if( fabsf(det) < std::numeric_limits<float>::epsilon() ) {
+			continue;
+		}
+		const float invDet = 1.0f / det;
+		const cc::Vec3f t = point - v0;
+		const float u = t.dot(p) * invDet;
+		if( u < 0.0f || u > 1.0f ) {
+			continue;
+		}
+		const cc::Vec3f q = t.cross(e1);
+		const float v = dir.dot(q) * invDet;
+		if( v < 0.0f || u + v > 1.0f ) {
+			continue;
+		}
+		if( e2.dot(q) * invDet > 0.0f ) {
+			++crossings;
+		}
+	}
+	return (crossings % 2) == 1;
+}
+
 Model::Edge::Edge() {
 	idx[0]=idx[1] = -1;
 	face[0]=face[1] = -1;
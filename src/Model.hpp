@@ -40,6 +40,8 @@ public:
 	const std::vector<Edge>& getEdges() const;
 
 	BoundingBox computeBoundingBox() const;
+	// tests if a point is inside of the (closed) model by counting ray crossings
+	bool containsPoint( const cc::Vec3f& point ) const;
 
 private:
 	std::vector<Vertex> _vertices;
@@ -0,0 +1,37 @@
+#ifndef __parallel_for__
+#define __parallel_for__
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+/**
+ * Runs task(i) for every i in [0, count), with threads taking the next i as they finish.
+ * @param[in] threadCount Maximum number of threads to run tasks on.
+ * @param[in] count       Number of tasks.
+ * @param[in] task        Task to run, called concurrently when more than one thread is used.
+ */
+template<typename Task>
+inline void parallelFor( unsigned int threadCount, int count, const Task& task ) {
+	std::atomic<int> next(0);
+	const auto worker = [&]() {
+		for( int i = next++; i < count; i = next++ ) {
+			task(i);
+		}
+	};
+	const int usedThreads = std::max<int>(1, std::min<int>(static_cast<int>(threadCount), count));
+	if( 1 == usedThreads ) {
+		worker();
+		return;
+	}
+	std::vector<std::thread> threads;
+	for( int t = 0; t < usedThreads; ++t ) {
+		threads.push_back(std::thread(worker));
+	}
+	for( auto& t : threads ) {
+		t.join();
+	}
+}
+
+#endif /* __parallel_for__ */
\ No newline at end of file
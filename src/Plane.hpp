@@ -2,20 +2,24 @@
 #define __plane__
 
 #include <vector>
+#include <climits>
 #include <cc/Vec3.hpp>
 #include <cc/Vec4.hpp>
 
 struct Plane {
+	static const int NO_NEIGHBOR = INT_MIN;
+
 	cc::Vec3f normal;
 	float constant;
 	cc::Vec3f pointOnPlane; // OPTIONAL - SET TO ZERO BY DEFAULT.
+	int neighborId; // OPTIONAL - ID OF THE SEED ON THE OTHER SIDE OF A CELL'S PLANE, NEGATIVE FOR WALLS.  SET TO NO_NEIGHBOR BY DEFAULT.
 
 	Plane()
-		: normal(cc::Vec3f::up()), constant(0.0f) {
+		: normal(cc::Vec3f::up()), constant(0.0f), neighborId(NO_NEIGHBOR) {
 	}
 
 	Plane( const cc::Vec3f& inNormal, const float inConstant )
-		: normal(inNormal), constant(inConstant) {
+		: normal(inNormal), constant(inConstant), neighborId(NO_NEIGHBOR) {
 	}
 
 	float unsignedDistance( const cc::Vec3f& point ) const {
@@ -26,6 +30,14 @@ struct Plane {
 		return (normal.x * point.x + normal.y * point.y + normal.z * point.z + constant);
 	}
 
+	// the same plane facing the other way
+	Plane flipped() const {
+		Plane result = *this;
+		result.normal = -normal;
+		result.constant = -constant;
+		return result;
+	}
+
 	static Plane constructFromPointNormal( const cc::Vec3f& point, const cc::Vec3f& normal ) {
 		Plane result;
 		const cc::Vec3f normalizedNormal = normal.normalized();
@@ -121,6 +121,35 @@ namespace PlaneHelper {
 		outModel.addIndex(1);
 
 	}
+
+	// builds a 26-sided discrete oriented polytope around the model: for each of 13 fixed directions (axes, edge and corner
+	// diagonals) a pair of planes at the model's extents along it.  the planes face inwards and are pushed out by padding.
+	static void boundingPlanes( const Model& model, float padding, std::vector<Plane>& outPlanes ) {
+		outPlanes.clear();
+		const std::vector<Vertex>& vertices = model.getVertices();
+		if( vertices.empty() ) {
+			return;
+		}
+
+		const cc::Vec3f directions[13] = {
+			cc::Vec3f(1.0f, 0.0f, 0.0f), cc::Vec3f(0.0f, 1.0f, 0.0f), cc::Vec3f(0.0f, 0.0f, 1.0f),
+			cc::Vec3f(1.0f, 1.0f, 0.0f), cc::Vec3f(1.0f, -1.0f, 0.0f), cc::Vec3f(1.0f, 0.0f, 1.0f),
+			cc::Vec3f(1.0f, 0.0f, -1.0f), cc::Vec3f(0.0f, 1.0f, 1.0f), cc::Vec3f(0.0f, 1.0f, -1.0f),
+			cc::Vec3f(1.0f, 1.0f, 1.0f), cc::Vec3f(1.0f, 1.0f, -1.0f), cc::Vec3f(1.0f, -1.0f, 1.0f), cc::Vec3f(1.0f, -1.0f, -1.0f)
+		};
+		for( const auto& direction : directions ) {
+			const cc::Vec3f dir = direction.normalized();
+			float minDist = std::numeric_limits<float>::max();
+			float maxDist = -std::numeric_limits<float>::max();
+			for( const auto& vtx : vertices ) {
+				const float dist = vtx.position.dot(dir);
+				minDist = (dist < minDist) ? dist : minDist;
+				maxDist = (dist > maxDist) ? dist : maxDist;
+			}
+			outPlanes.push_back(Plane(dir, -(minDist - padding)));
+			outPlanes.push_back(Plane(dir * -1.0f, maxDist + padding));
+		}
+	}
 } // PlaneHelper
 
 #endif /* __plane_helper__ */
\ No newline at end of file
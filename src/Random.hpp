@@ -2,44 +2,142 @@
 #define __random__
 
 #include <random>
+#include <cstdint>
+#include <limits>
+#include <cmath>
+#include <algorithm>
 #include <cc/Vec3.hpp>
 #include "BoundingBox.hpp"
 
+// counter-based generator (philox4x32-10).  each draw is a pure function of the seed, a stream, an index within the
+// stream, and how many draws were made before it at that index, so a generator can be placed at any (stream, index)
+// and produce the same values no matter which thread reaches it first.  reals and ints are mapped from the raw words
+// here rather than by <random> distributions, whose output differs between standard libraries.
 template <class RealType, class IntType>
 class Random {
+public:
+	// points generated at once by the block functions
+	static const unsigned int LANES = 16;
+
 public:
 	Random() {
 		std::random_device dev;
-		_mt = std::mt19937(dev());
+		setSeed(dev());
 	}
 	Random( unsigned int seed ) {
-		_mt = std::mt19937(seed);
+		setSeed(seed);
+	}
+	Random( unsigned int seed, unsigned int stream, unsigned int index ) {
+		setSeed(seed);
+		seek(stream, index);
 	}
 	~Random() {
 	}
 
 	void setSeed( unsigned int seed ) {
-		_mt = std::mt19937(seed);
+		_key[0] = seed;
+		_key[1] = 0;
+		seek(0, 0);
+	}
+
+	/**
+	 * Moves to the start of the draws for an index of a stream.
+	 * @param[in] stream Stream to draw from, such as a kind of point.
+	 * @param[in] index  Index within the stream, such as a point's index.
+	 */
+	void seek( unsigned int stream, unsigned int index ) {
+		_counter[0] = 0;
+		_counter[1] = index;
+		_counter[2] = stream;
+		_counter[3] = 0;
+		_wordIndex = 4;
 	}
 
 	RealType nextReal() {
-		std::uniform_real_distribution<RealType> dist;
-		return dist(_mt);
+		return nextReal(static_cast<RealType>(0), static_cast<RealType>(1));
 	}
 
 	RealType nextReal( const RealType min, const RealType max ) {
-		std::uniform_real_distribution<RealType> dist(min, max);
-		return dist(_mt);
+		const double unit = static_cast<double>(nextWord()) * (1.0 / 4294967296.0);
+		return static_cast<RealType>(static_cast<double>(min) + (static_cast<double>(max) - static_cast<double>(min)) * unit);
 	}
 
 	IntType nextInt() {
-		std::uniform_int_distribution<IntType> dist;
-		return dist(_mt);
+		return nextInt(0, std::numeric_limits<IntType>::max());
 	}
 
 	IntType nextInt( const IntType min, const IntType max ) {
-		std::uniform_int_distribution<IntType> dist(min, max);
-		return dist(_mt);
+		// lemire's multiply and shift, redrawing the few words that would make some values more likely than others
+		const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - static_cast<int64_t>(min)) + 1;
+		uint64_t product = static_cast<uint64_t>(nextWord()) * range;
+		if( static_cast<uint32_t>(product) < range ) {
+			const uint64_t threshold = (0x100000000ull - range) % range;
+			while( static_cast<uint32_t>(product) < threshold ) {
+				product = static_cast<uint64_t>(nextWord()) * range;
+			}
+		}
+		return static_cast<IntType>(static_cast<int64_t>(min) + static_cast<int64_t>(product >> 32));
+	}
+
+	/**
+	 * Generates uniform points in a box into separate x, y, and z arrays.  Point i is drawn from index firstIndex+i of the
+	 * stream, so blocks of a stream can be generated in any order.  Does not change the generator's position.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points.
+	 * @param[in]  bb         Box to generate points in.
+	 * @param[out] outX       Array of count x coordinates.
+	 * @param[out] outY       Array of count y coordinates.
+	 * @param[out] outZ       Array of count z coordinates.
+	 */
+	void boxPoints( unsigned int stream, unsigned int firstIndex, unsigned int count, const BoundingBox& bb, float* outX, float* outY, float* outZ ) const {
+		const float minX = bb.minX();
+		const float minY = bb.minY();
+		const float minZ = bb.minZ();
+		const float sizeX = bb.maxX() - minX;
+		const float sizeY = bb.maxY() - minY;
+		const float sizeZ = bb.maxZ() - minZ;
+		uint32_t words[4][LANES];
+		for( unsigned int first = 0; first < count; first += LANES ) {
+			philoxLanes(stream, firstIndex + first, words);
+			const unsigned int lanes = std::min<unsigned int>(LANES, count - first);
+			for( unsigned int lane = 0; lane < lanes; ++lane ) {
+				outX[first + lane] = minX + sizeX * unitFloat(words[0][lane]);
+				outY[first + lane] = minY + sizeY * unitFloat(words[1][lane]);
+				outZ[first + lane] = minZ + sizeZ * unitFloat(words[2][lane]);
+			}
+		}
+	}
+
+	/**
+	 * Generates normally distributed points around a center into separate x, y, and z arrays.  Point i is drawn from
+	 * index firstIndex+i of the stream.  Does not change the generator's position.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points.
+	 * @param[in]  center     Mean of the points.
+	 * @param[in]  deviation  Standard deviation along each axis.
+	 * @param[out] outX       Array of count x coordinates.
+	 * @param[out] outY       Array of count y coordinates.
+	 * @param[out] outZ       Array of count z coordinates.
+	 */
+	void gaussianPoints( unsigned int stream, unsigned int firstIndex, unsigned int count, const cc::Vec3f& center, float deviation, float* outX, float* outY, float* outZ ) const {
+		// box-muller turns each pair of words into two normal values, so the four words of a block make three of them (and a spare)
+		uint32_t words[4][LANES];
+		for( unsigned int first = 0; first < count; first += LANES ) {
+			philoxLanes(stream, firstIndex + first, words);
+			const unsigned int lanes = std::min<unsigned int>(LANES, count - first);
+			for( unsigned int lane = 0; lane < lanes; ++lane ) {
+				// the first of each pair must not be zero for its log
+				const float lengthXY = deviation * sqrtf(-2.0f * logf(1.0f - unitFloat(words[0][lane])));
+				const float angleXY = TWO_PI * unitFloat(words[1][lane]);
+				const float lengthZ = deviation * sqrtf(-2.0f * logf(1.0f - unitFloat(words[2][lane])));
+				const float angleZ = TWO_PI * unitFloat(words[3][lane]);
+				outX[first + lane] = center.x + lengthXY * cosf(angleXY);
+				outY[first + lane] = center.y + lengthXY * sinf(angleXY);
+				outZ[first + lane] = center.z + lengthZ * cosf(angleZ);
+			}
+		}
 	}
 
 	cc::Vec3f pointInBBox( const BoundingBox& bb ) {
@@ -113,7 +211,86 @@ public:
 	}
 
 private:
-	std::mt19937 _mt;
+	static constexpr float TWO_PI = 6.28318531f;
+
+	uint32_t nextWord() {
+		// each block of the counter gives four words
+		if( _wordIndex >= 4 ) {
+			philox(_counter, _key, _words);
+			++_counter[0];
+			_wordIndex = 0;
+		}
+		return _words[_wordIndex++];
+	}
+
+	// maps the top 24 bits of a word to [0, 1).  the shifted word fits a signed int, which every vector unit can convert.
+	static float unitFloat( uint32_t word ) {
+		return static_cast<float>(static_cast<int32_t>(word >> 8)) * (1.0f / 16777216.0f);
+	}
+
+	// philox for the first block of LANES consecutive indices at once.  each round is a loop over the lanes with no
+	// dependencies between them, so that compilers can turn it into vector instructions.
+	void philoxLanes( unsigned int stream, unsigned int firstIndex, uint32_t outWords[4][LANES] ) const {
+		uint32_t c0[LANES];
+		uint32_t c1[LANES];
+		uint32_t c2[LANES];
+		uint32_t c3[LANES];
+		for( unsigned int lane = 0; lane < LANES; ++lane ) {
+			c0[lane] = 0;
+			c1[lane] = firstIndex + lane;
+			c2[lane] = stream;
+			c3[lane] = 0;
+		}
+		uint32_t k0 = _key[0];
+		uint32_t k1 = _key[1];
+		for( int round = 0; round < 10; ++round ) {
+			for( unsigned int lane = 0; lane < LANES; ++lane ) {
+				const uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0[lane];
+				const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2[lane];
+				c0[lane] = static_cast<uint32_t>(product1 >> 32) ^ c1[lane] ^ k0;
+				c2[lane] = static_cast<uint32_t>(product0 >> 32) ^ c3[lane] ^ k1;
+				c1[lane] = static_cast<uint32_t>(product1);
+				c3[lane] = static_cast<uint32_t>(product0);
+			}
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+		for( unsigned int lane = 0; lane < LANES; ++lane ) {
+			outWords[0][lane] = c0[lane];
+			outWords[1][lane] = c1[lane];
+			outWords[2][lane] = c2[lane];
+			outWords[3][lane] = c3[lane];
+		}
+	}
+
+	static void philox( const uint32_t counter[4], const uint32_t key[2], uint32_t outWords[4] ) {
+		uint32_t c0 = counter[0];
+		uint32_t c1 = counter[1];
+		uint32_t c2 = counter[2];
+		uint32_t c3 = counter[3];
+		uint32_t k0 = key[0];
+		uint32_t k1 = key[1];
+		for( int round = 0; round < 10; ++round ) {
+			const uint64_t product0 = static_cast<uint64_t>(0xD2511F53u) * c0;
+			const uint64_t product1 = static_cast<uint64_t>(0xCD9E8D57u) * c2;
+			c0 = static_cast<uint32_t>(product1 >> 32) ^ c1 ^ k0;
+			c2 = static_cast<uint32_t>(product0 >> 32) ^ c3 ^ k1;
+			c1 = static_cast<uint32_t>(product1);
+			c3 = static_cast<uint32_t>(product0);
+			k0 += 0x9E3779B9u;
+			k1 += 0xBB67AE85u;
+		}
+		outWords[0] = c0;
+		outWords[1] = c1;
+		outWords[2] = c2;
+		outWords[3] = c3;
+	}
+
+private:
+	uint32_t _key[2];
+	uint32_t _counter[4]; // block within the index, index, stream, unused
+	uint32_t _words[4];
+	unsigned int _wordIndex;
 };
 
 #endif /* __random__ */
\ No newline at end of file
@@ -74,6 +74,150 @@ namespace HadanArgs {
 	static const char* HadanMultiThreadingLong = "-multithreaded";
 	static const MSyntax::MArgType HadanMultiThreadingType = MSyntax::kBoolean;
 
+	// cull exterior cells
+	static const char* HadanCullExterior = "-ce";
+	static const char* HadanCullExteriorLong = "-cullExterior";
+	static const MSyntax::MArgType HadanCullExteriorType = MSyntax::kBoolean;
+
+	// cell type
+	static const char* HadanCellType = "-ct";
+	static const char* HadanCellTypeLong = "-cellType";
+	static const MSyntax::MArgType HadanCellTypeType = MSyntax::kString;
+
+	// maximum sample point radius
+	static const char* HadanRadiusPercentage = "-rp";
+	static const char* HadanRadiusPercentageLong = "-radiusPercent";
+	static const MSyntax::MArgType HadanRadiusPercentageType = MSyntax::kDouble;
+
+	// save cell pattern
+	static const char* HadanSavePattern = "-sp";
+	static const char* HadanSavePatternLong = "-savePattern";
+	static const MSyntax::MArgType HadanSavePatternType = MSyntax::kString;
+
+	// cell pattern
+	static const char* HadanPattern = "-pat";
+	static const char* HadanPatternLong = "-pattern";
+	static const MSyntax::MArgType HadanPatternType = MSyntax::kString;
+
+	// cell pattern tiles
+	static const char* HadanPatternTiles = "-pti";
+	static const char* HadanPatternTilesLong = "-patternTiles";
+	static const MSyntax::MArgType HadanPatternTilesType = MSyntax::kUnsigned;
+
+	// cell pattern rotation
+	static const char* HadanPatternRotation = "-pr";
+	static const char* HadanPatternRotationLong = "-patternRotation";
+	static const MSyntax::MArgType HadanPatternRotationType = MSyntax::kDouble;
+
+	// incremental session
+	static const char* HadanSession = "-ses";
+	static const char* HadanSessionLong = "-session";
+	static const MSyntax::MArgType HadanSessionType = MSyntax::kBoolean;
+
+	// recursive fracturing depth
+	static const char* HadanDepth = "-dep";
+	static const char* HadanDepthLong = "-depth";
+	static const MSyntax::MArgType HadanDepthType = MSyntax::kUnsigned;
+
+	// per-level point count for recursive fracturing
+	static const char* HadanLevelCount = "-lc";
+	static const char* HadanLevelCountLong = "-levelCount";
+	static const MSyntax::MArgType HadanLevelCountType = MSyntax::kUnsigned;
+
+	// sample points per voronoi tile
+	static const char* HadanTileSeeds = "-tse";
+	static const char* HadanTileSeedsLong = "-tileSeeds";
+	static const MSyntax::MArgType HadanTileSeedsType = MSyntax::kUnsigned;
+
+	// minimum cell face area
+	static const char* HadanMinFaceArea = "-mfa";
+	static const char* HadanMinFaceAreaLong = "-minFaceArea";
+	static const MSyntax::MArgType HadanMinFaceAreaType = MSyntax::kDouble;
+
+	// cell face merge angle
+	static const char* HadanMergeAngle = "-mga";
+	static const char* HadanMergeAngleLong = "-mergeAngle";
+	static const MSyntax::MArgType HadanMergeAngleType = MSyntax::kDouble;
+
+	// lloyd relaxation iterations
+	static const char* HadanRelaxIterations = "-ri";
+	static const char* HadanRelaxIterationsLong = "-relaxIterations";
+	static const MSyntax::MArgType HadanRelaxIterationsType = MSyntax::kUnsigned;
+
+	// slab cutting plane
+	static const char* HadanCutPlane = "-cpl";
+	static const char* HadanCutPlaneLong = "-cutPlane";
+	static const MSyntax::MArgType HadanCutPlaneType = MSyntax::kDouble;
+
+	// slab mesh splitting
+	static const char* HadanSplitMesh = "-spm";
+	static const char* HadanSplitMeshLong = "-splitMesh";
+	static const MSyntax::MArgType HadanSplitMeshType = MSyntax::kBoolean;
+
+	// lattice cell counts
+	static const char* HadanLatticeCount = "-lct";
+	static const char* HadanLatticeCountLong = "-latticeCount";
+	static const MSyntax::MArgType HadanLatticeCountType = MSyntax::kUnsigned;
+
+	// lattice plane jitter
+	static const char* HadanLatticeJitter = "-ljt";
+	static const char* HadanLatticeJitterLong = "-latticeJitter";
+	static const MSyntax::MArgType HadanLatticeJitterType = MSyntax::kDouble;
+
+	// radial crack count
+	static const char* HadanWedgeCount = "-wdc";
+	static const char* HadanWedgeCountLong = "-wedgeCount";
+	static const MSyntax::MArgType HadanWedgeCountType = MSyntax::kUnsigned;
+
+	// radial ring count
+	static const char* HadanRingCount = "-rgc";
+	static const char* HadanRingCountLong = "-ringCount";
+	static const MSyntax::MArgType HadanRingCountType = MSyntax::kUnsigned;
+
+	// radial ring spacing growth
+	static const char* HadanRingGrowth = "-rgg";
+	static const char* HadanRingGrowthLong = "-ringGrowth";
+	static const MSyntax::MArgType HadanRingGrowthType = MSyntax::kDouble;
+
+	// radial crack and ring jitter
+	static const char* HadanRadialJitter = "-rj";
+	static const char* HadanRadialJitterLong = "-radialJitter";
+	static const MSyntax::MArgType HadanRadialJitterType = MSyntax::kDouble;
+
+	// chunk adjacency graph output
+	static const char* HadanAdjacency = "-adj";
+	static const char* HadanAdjacencyLong = "-adjacency";
+	static const MSyntax::MArgType HadanAdjacencyType = MSyntax::kString;
+
+	// poisson minimum spacing
+	static const char* HadanMinSpacing = "-msp";
+	static const char* HadanMinSpacingLong = "-minSpacing";
+	static const MSyntax::MArgType HadanMinSpacingType = MSyntax::kDouble;
+
+	// poisson blue noise tile
+	static const char* HadanBlueNoiseTile = "-bnt";
+	static const char* HadanBlueNoiseTileLong = "-blueNoiseTile";
+	static const MSyntax::MArgType HadanBlueNoiseTileType = MSyntax::kString;
+
+	// points inside mesh
+	static const char* HadanInsideMesh = "-im";
+	static const char* HadanInsideMeshLong = "-insideMesh";
+	static const MSyntax::MArgType HadanInsideMeshType = MSyntax::kBoolean;
+
+	// bezier cracks
+	static const char* HadanCrack = "-crk";
+	static const char* HadanCrackLong = "-crack";
+	static const MSyntax::MArgType HadanCrackType = MSyntax::kUnsigned;
+	static const MSyntax::MArgType HadanCrackFluxType = MSyntax::kDouble;
+
+	// surface sampling
+	static const char* HadanSurfaceDepth = "-sdp";
+	static const char* HadanSurfaceDepthLong = "-surfaceDepth";
+	static const MSyntax::MArgType HadanSurfaceDepthType = MSyntax::kDouble;
+	static const char* HadanColorWeight = "-cwt";
+	static const char* HadanColorWeightLong = "-colorWeight";
+	static const MSyntax::MArgType HadanColorWeightType = MSyntax::kBoolean;
+
 	static MSyntax Syntax() {
 		MSyntax syntax;
 		syntax.addFlag(HadanMeshName, HadanMeshNameLong, HadanMeshNameType);
@@ -90,9 +234,41 @@ namespace HadanArgs {
 		syntax.addFlag(HadanSmoothingAngle, HadanSmoothingAngleLong, HadanSmoothingAngleType);
 		syntax.addFlag(HadanBezierMinDist, HadanBezierMinDistLong, HadanBezierMinDistType);
 		syntax.addFlag(HadanMultiThreading, HadanMultiThreadingLong, HadanMultiThreadingType);
+		syntax.addFlag(HadanCullExterior, HadanCullExteriorLong, HadanCullExteriorType);
+		syntax.addFlag(HadanCellType, HadanCellTypeLong, HadanCellTypeType);
+		syntax.addFlag(HadanRadiusPercentage, HadanRadiusPercentageLong, HadanRadiusPercentageType);
+		syntax.addFlag(HadanSavePattern, HadanSavePatternLong, HadanSavePatternType);
+		syntax.addFlag(HadanPattern, HadanPatternLong, HadanPatternType);
+		syntax.addFlag(HadanPatternTiles, HadanPatternTilesLong, HadanPatternTilesType);
+		syntax.addFlag(HadanPatternRotation, HadanPatternRotationLong, HadanPatternRotationType, HadanPatternRotationType, HadanPatternRotationType);
+		syntax.addFlag(HadanSession, HadanSessionLong, HadanSessionType);
+		syntax.addFlag(HadanDepth, HadanDepthLong, HadanDepthType);
+		syntax.addFlag(HadanLevelCount, HadanLevelCountLong, HadanLevelCountType);
+		syntax.addFlag(HadanTileSeeds, HadanTileSeedsLong, HadanTileSeedsType);
+		syntax.addFlag(HadanMinFaceArea, HadanMinFaceAreaLong, HadanMinFaceAreaType);
+		syntax.addFlag(HadanMergeAngle, HadanMergeAngleLong, HadanMergeAngleType);
+		syntax.addFlag(HadanRelaxIterations, HadanRelaxIterationsLong, HadanRelaxIterationsType);
+		syntax.addFlag(HadanCutPlane, HadanCutPlaneLong, HadanCutPlaneType, HadanCutPlaneType, HadanCutPlaneType, HadanCutPlaneType, HadanCutPlaneType, HadanCutPlaneType);
+		syntax.addFlag(HadanSplitMesh, HadanSplitMeshLong, HadanSplitMeshType);
+		syntax.addFlag(HadanLatticeCount, HadanLatticeCountLong, HadanLatticeCountType, HadanLatticeCountType, HadanLatticeCountType);
+		syntax.addFlag(HadanLatticeJitter, HadanLatticeJitterLong, HadanLatticeJitterType);
+		syntax.addFlag(HadanWedgeCount, HadanWedgeCountLong, HadanWedgeCountType);
+		syntax.addFlag(HadanRingCount, HadanRingCountLong, HadanRingCountType);
+		syntax.addFlag(HadanRingGrowth, HadanRingGrowthLong, HadanRingGrowthType);
+		syntax.addFlag(HadanRadialJitter, HadanRadialJitterLong, HadanRadialJitterType);
+		syntax.addFlag(HadanAdjacency, HadanAdjacencyLong, HadanAdjacencyType);
+		syntax.addFlag(HadanMinSpacing, HadanMinSpacingLong, HadanMinSpacingType);
+		syntax.addFlag(HadanBlueNoiseTile, HadanBlueNoiseTileLong, HadanBlueNoiseTileType);
+		syntax.addFlag(HadanInsideMesh, HadanInsideMeshLong, HadanInsideMeshType);
+		syntax.addFlag(HadanCrack, HadanCrackLong, HadanCrackType, HadanCrackType, HadanCrackFluxType);
+		syntax.addFlag(HadanSurfaceDepth, HadanSurfaceDepthLong, HadanSurfaceDepthType);
+		syntax.addFlag(HadanColorWeight, HadanColorWeightLong, HadanColorWeightType);
 		syntax.makeFlagMultiUse(HadanPoint);
+		syntax.makeFlagMultiUse(HadanCutPlane);
+		syntax.makeFlagMultiUse(HadanLevelCount);
+		syntax.makeFlagMultiUse(HadanCrack);
 		return syntax;
 	}
 }
 
-#endif /* __syntax__ */
+#endif /* __syntax__ */
\ No newline at end of file
@@ -1,26 +1,28 @@
 #include "Cell.hpp"
 
-Cell::Cell() {
+Cell::Cell()
+	: _faceOffsets(1, 0) {
 }
 
-void Cell::addPlane( const Plane& plane ) {
-	_planes.push_back(plane);
-}
-
-void Cell::addPoint( const cc::Vec3f& point ) {
-	_points.push_back(point);
+void Cell::clear() {
+	_planes.clear();
+	_vertices.clear();
+	_faceOffsets.resize(1);
+	_faceIndices.clear();
 }
 
-void Cell::addCount( int count ) {
-	_counts.push_back(count);
+void Cell::addPlane( const Plane& plane ) {
+	_planes.push_back(plane);
 }
 
-void Cell::addIndex( int index ) {
-	_indices.push_back(index);
+int Cell::addVertex( const cc::Vec3f& vertex ) {
+	_vertices.push_back(vertex);
+	return static_cast<int>(_vertices.size()) - 1;
 }
 
-void Cell::addPlanePoints( const std::vector<cc::Vec3f>& points ) {
-	_planePoints.push_back(points);
+void Cell::addFace( const int* indices, int count ) {
+	_faceIndices.insert(_faceIndices.end(), indices, indices + count);
+	_faceOffsets.push_back(static_cast<int>(_faceIndices.size()));
 }
 
 unsigned int Cell::getPlaneCount() const {
@@ -31,18 +33,18 @@ const std::vector<Plane>& Cell::getPlanes() const {
 	return _planes;
 }
 
-const std::vector<cc::Vec3f>& Cell::getPoints() const {
-	return _points;
+const std::vector<cc::Vec3f>& Cell::getVertices() const {
+	return _vertices;
 }
 
-const std::vector<int>& Cell::getCounts() const {
-	return _counts;
+unsigned int Cell::getFaceCount() const {
+	return static_cast<unsigned int>(_faceOffsets.size()) - 1;
 }
 
-const std::vector<int>& Cell::getIndices() const {
-	return _indices;
+int Cell::getFaceSize( unsigned int face ) const {
+	return _faceOffsets[face+1] - _faceOffsets[face];
 }
 
-const std::vector<std::vector<cc::Vec3f>>& Cell::getPlanePoints() const {
-	return _planePoints;
+const int* Cell::getFaceIndices( unsigned int face ) const {
+	return _faceIndices.data() + _faceOffsets[face];
 }
\ No newline at end of file
@@ -5,31 +5,32 @@
 #include <Plane.hpp>
 #include <cc/Vec3.hpp>
 
+// a convex cutting cell.  faces index into a vertex pool shared by the whole cell, and planes are stored packed,
+// so a cell is a handful of flat arrays that keep their capacity when the cell is cleared and refilled.
 class Cell {
 public:
 	Cell();
 
+	void clear();
+
 	void addPlane( const Plane& plane );
-	void addPoint( const cc::Vec3f& point );
-	void addCount( int count );
-	void addIndex( int index );
-	void addPlanePoints( const std::vector<cc::Vec3f>& points );
+	int addVertex( const cc::Vec3f& vertex );
+	void addFace( const int* indices, int count );
 
 	unsigned int getPlaneCount() const;
 	const std::vector<Plane>& getPlanes() const;
-	const std::vector<cc::Vec3f>& getPoints() const;
-	const std::vector<int>& getCounts() const;
-	const std::vector<int>& getIndices() const;
-	const std::vector<std::vector<cc::Vec3f>>& getPlanePoints() const;
+
+	const std::vector<cc::Vec3f>& getVertices() const;
+	unsigned int getFaceCount() const;
+	int getFaceSize( unsigned int face ) const;
+	const int* getFaceIndices( unsigned int face ) const;
 
 private:
 	std::vector<Plane> _planes;
 
-	std::vector<std::vector<cc::Vec3f>> _planePoints;
-
-	std::vector<cc::Vec3f> _points;
-	std::vector<int> _counts; // number of indices per face, e.g. 3,4 would be 3 indices followed by 4 indices
-	std::vector<int> _indices; // actual indices in the format [index*counts[0], index*counts[1], ...]
+	std::vector<cc::Vec3f> _vertices; // vertex pool shared by all faces
+	std::vector<int> _faceOffsets; // start of each face in _faceIndices, plus one past the last face
+	std::vector<int> _faceIndices; // vertex indices of all faces, back to back
 };
 
-#endif /*  */
\ No newline at end of file
+#endif /* __cell__ */
\ No newline at end of file
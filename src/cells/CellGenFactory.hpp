@@ -4,11 +4,23 @@
 #include <memory>
 #include "ICellGen.hpp"
 #include "VoronoiCelGen/VoronoiCellGen.hpp"
+#include "PowerCellGen/PowerCellGen.hpp"
+#include "PatternCellGen/PatternCellGen.hpp"
+#include "SlabCellGen/SlabCellGen.hpp"
+#include "LatticeCellGen/LatticeCellGen.hpp"
+#include "RadialCellGen/RadialCellGen.hpp"
 
 class CellGenFactory {
 public:
 	enum class Type {
-		Voronoi
+		Voronoi,
+		Power,
+		Pattern,
+		Slab,
+		Grid,
+		Brick,
+		Hex,
+		Radial
 	};
 
 	static std::unique_ptr<ICellGen> create( Type type ) {
@@ -16,6 +28,34 @@ public:
 			case Type::Voronoi: {
 				return std::make_unique<VoronoiCellGen>();
 			}
+
+			case Type::Power: {
+				return std::make_unique<PowerCellGen>();
+			}
+
+			case Type::Pattern: {
+				return std::make_unique<PatternCellGen>();
+			}
+
+			case Type::Slab: {
+				return std::make_unique<SlabCellGen>();
+			}
+
+			case Type::Grid: {
+				return std::make_unique<LatticeCellGen>(LatticeCellGen::Layout::Grid);
+			}
+
+			case Type::Brick: {
+				return std::make_unique<LatticeCellGen>(LatticeCellGen::Layout::Brick);
+			}
+
+			case Type::Hex: {
+				return std::make_unique<LatticeCellGen>(LatticeCellGen::Layout::Hex);
+			}
+
+			case Type::Radial: {
+				return std::make_unique<RadialCellGen>();
+			}
 		}
 		return nullptr;
 	}
@@ -0,0 +1,77 @@
+#ifndef __cell_gen_info__
+#define __cell_gen_info__
+
+#include <vector>
+#include <string>
+#include <cc/Vec3.hpp>
+#include <Plane.hpp>
+
+struct CellGenInfo {
+	// number of threads to compute cells with
+	unsigned int threadCount;
+	// whether generated cells need their cutting planes
+	bool needsPlanes;
+	// whether generated cells need their vertices and faces
+	bool needsFaces;
+	// optional convex region (the positive side of every plane) that cells are trimmed to
+	std::vector<Plane> walls;
+	// per-sample-point radii for weighted (power diagram) generation; larger radii give larger cells
+	std::vector<float> sampleRadii;
+	// whether cells wrap around the bounding box so that they tile space (walls are ignored)
+	bool periodic;
+	// precomputed CellPattern to fit to the bounding box instead of computing cells
+	std::string patternPath;
+	// number of copies of the pattern spanning the bounding box along each axis
+	unsigned int patternTiles;
+	// rotation of the pattern about the bounding box's center in degrees
+	cc::Vec3f patternRotation;
+	// when above zero, voronoi cells are computed a tile of space at a time with around this many sample points per tile
+	unsigned int tileSeedCount;
+	// planes for slab cells to be cut by in order, instead of splitting sample points
+	std::vector<Plane> cutPlanes;
+	// generated cells' faces smaller than this percentage of the cell's surface area are dropped before slicing
+	double minFaceAreaPercent;
+	// generated cells' faces whose normals are within this many degrees of each other are merged before slicing
+	double mergeAngle;
+	// number of grid, brick, or hex lattice cells along each axis
+	unsigned int latticeCounts[3];
+	// percentage of lattice cell spacing that the planes between lattice cells are moved and tilted by at random
+	double latticeJitter;
+	// seed used to reproduce random cell layouts
+	unsigned int seed;
+	// whether impactPoint is given; radial cells are centered on the bounding box otherwise
+	bool hasImpactPoint;
+	// point that radial cells shatter out from
+	cc::Vec3f impactPoint;
+	// number of cracks running out from the impact point of radial cells
+	unsigned int radialWedges;
+	// number of rings crossing the cracks of radial cells
+	unsigned int radialRings;
+	// ratio of each ring's width to the width of the ring inside of it
+	double radialGrowth;
+	// percentage of crack and ring spacing that radial cracks are turned and rings moved by at random
+	double radialJitter;
+
+	CellGenInfo() {
+		threadCount = 1;
+		needsPlanes = true;
+		needsFaces = true;
+		periodic = false;
+		patternTiles = 1;
+		patternRotation = cc::Vec3f(0.0f, 0.0f, 0.0f);
+		tileSeedCount = 0;
+		minFaceAreaPercent = 0.0;
+		mergeAngle = 0.0;
+		latticeCounts[0] = latticeCounts[1] = latticeCounts[2] = 1;
+		latticeJitter = 0.0;
+		seed = 0;
+		hasImpactPoint = false;
+		impactPoint = cc::Vec3f(0.0f, 0.0f, 0.0f);
+		radialWedges = 12;
+		radialRings = 6;
+		radialGrowth = 1.4;
+		radialJitter = 0.0;
+	}
+};
+
+#endif /* __cell_gen_info__ */
\ No newline at end of file
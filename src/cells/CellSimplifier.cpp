@@ -0,0 +1,274 @@
+#include "CellSimplifier.hpp"
+#include <voro++.hh>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+// largest volume, relative to the original, that a simplified cell may differ from it by
+static const double MAX_VOLUME_ERROR = 0.02;
+
+// cuts a box around center down to the positive side of every plane.  each face of the result is tagged with the index
+// of its plane, or a negative id for faces of the box.
+static bool cutPlanes( const std::vector<Plane>& planes, const cc::Vec3f& center, const cc::Vec3f& boxMin, const cc::Vec3f& boxMax, voro::voronoicell_neighbor& outCell ) {
+	outCell.init(boxMin.x - center.x, boxMax.x - center.x, boxMin.y - center.y, boxMax.y - center.y, boxMin.z - center.z, boxMax.z - center.z);
+	for( size_t i = 0; i < planes.size(); ++i ) {
+		// voro++ keeps the side where dot(n, v) < rsq/2 for v relative to the center, so our normals are flipped
+		const Plane& plane = planes[i];
+		const double distance = static_cast<double>(plane.signedDistance(center));
+		if( !outCell.nplane(-plane.normal.x, -plane.normal.y, -plane.normal.z, 2.0 * distance, static_cast<int>(i)) ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+CellSimplifier::CellSimplifier( const CellGenInfo& info ) {
+	_minFaceAreaFraction = static_cast<float>(info.minFaceAreaPercent * 0.01);
+	_minMergeDot = (info.mergeAngle > 0.0) ? cosf(static_cast<float>(info.mergeAngle) * 0.0174532925f) : 1.0f;
+}
+
+bool CellSimplifier::isEnabled() const {
+	return (_minFaceAreaFraction > 0.0f) || (_minMergeDot < 1.0f);
+}
+
+bool CellSimplifier::simplify( const Cell& cell, Cell& outCell ) const {
+	const std::vector<Plane>& planes = cell.getPlanes();
+	const std::vector<cc::Vec3f>& vertices = cell.getVertices();
+	if( planes.empty() || vertices.empty() ) {
+		return false;
+	}
+
+	// cells are convex, so the average vertex is inside.  the box is far enough out that only unbounded cells touch it.
+	cc::Vec3f center;
+	cc::Vec3f vertsMin(std::numeric_limits<float>::max());
+	cc::Vec3f vertsMax(-std::numeric_limits<float>::max());
+	for( const auto& vtx : vertices ) {
+		center += vtx;
+		vertsMin.x = std::min<float>(vertsMin.x, vtx.x);
+		vertsMin.y = std::min<float>(vertsMin.y, vtx.y);
+		vertsMin.z = std::min<float>(vertsMin.z, vtx.z);
+		vertsMax.x = std::max<float>(vertsMax.x, vtx.x);
+		vertsMax.y = std::max<float>(vertsMax.y, vtx.y);
+		vertsMax.z = std::max<float>(vertsMax.z, vtx.z);
+	}
+	center /= static_cast<float>(vertices.size());
+	const cc::Vec3f vertsSize = vertsMax - vertsMin;
+	const cc::Vec3f boxMin = vertsMin - vertsSize;
+	const cc::Vec3f boxMax = vertsMax + vertsSize;
+
+	// rebuild the cell from its planes to find the area and corners of each plane's face
+	voro::voronoicell_neighbor vc;
+	if( !cutPlanes(planes, center, boxMin, boxMax, vc) ) {
+		return false;
+	}
+	const double originalVolume = vc.volume();
+	std::vector<int> neighbors;
+	std::vector<int> faceVertices;
+	std::vector<double> faceAreas;
+	vc.neighbors(neighbors);
+	vc.face_vertices(faceVertices);
+	vc.face_areas(faceAreas);
+
+	struct Face {
+		int plane;
+		float area;
+		std::vector<cc::Vec3f> vertices;
+	};
+	std::vector<Face> faces;
+	float totalArea = 0.0f;
+	for( size_t f = 0, start = 0; f < neighbors.size(); ++f ) {
+		const int vertsInFace = faceVertices[start];
+		if( neighbors[f] < 0 ) {
+			return false;
+		}
+		Face face;
+		face.plane = neighbors[f];
+		face.area = static_cast<float>(faceAreas[f]);
+		for( int j = 0; j < vertsInFace; ++j ) {
+			const int vtx = faceVertices[start+1+j];
+			face.vertices.push_back(center + cc::Vec3f(static_cast<float>(0.5 * vc.pts[3*vtx]), static_cast<float>(0.5 * vc.pts[3*vtx+1]), static_cast<float>(0.5 * vc.pts[3*vtx+2])));
+		}
+		faces.push_back(face);
+		totalArea += face.area;
+		start += vertsInFace + 1;
+	}
+
+	// merge faces into the largest face whose normal is within the angle, largest first so that small faces join big ones
+	std::sort(faces.begin(), faces.end(), []( const Face& lhs, const Face& rhs ) {
+		return lhs.area > rhs.area;
+	});
+	struct Group {
+		int plane; // plane of the group's largest face, whose neighbor is kept
+		float area;
+		cc::Vec3f weightedNormal;
+		std::vector<size_t> faces;
+	};
+	std::vector<Group> groups;
+	for( size_t f = 0; f < faces.size(); ++f ) {
+		const cc::Vec3f& normal = planes[faces[f].plane].normal;
+		Group* target = nullptr;
+		for( auto& group : groups ) {
+			if( planes[group.plane].normal.dot(normal) >= _minMergeDot ) {
+				target = &group;
+				break;
+			}
+		}
+		if( nullptr == target ) {
+			groups.push_back(Group());
+			target = &groups.back();
+			target->plane = faces[f].plane;
+			target->area = 0.0f;
+		}
+		target->area += faces[f].area;
+		target->weightedNormal += normal * faces[f].area;
+		target->faces.push_back(f);
+	}
+
+	// merged planes take their faces' area-weighted normal and pass through the innermost of their faces' corners, so every
+	// face they replace is on or outside of them and the simplified cell cannot reach past the original.  each is charged
+	// the volume it cuts from the original, and only used while the total charged stays small.
+	const auto replacementPlane = [&]( const Group& group ) {
+		const cc::Vec3f normal = group.weightedNormal.normalized();
+		cc::Vec3f pointOnPlane = faces[group.faces.front()].vertices.front();
+		for( const size_t f : group.faces ) {
+			for( const auto& vtx : faces[f].vertices ) {
+				if( normal.dot(vtx) > normal.dot(pointOnPlane) ) {
+					pointOnPlane = vtx;
+				}
+			}
+		}
+		Plane plane = Plane::constructFromPointNormal(pointOnPlane, normal);
+		plane.pointOnPlane = pointOnPlane;
+		plane.neighborId = planes[group.plane].neighborId;
+		return plane;
+	};
+	const auto cutVolume = [&]( const Plane& plane ) {
+		std::vector<Plane> clipped = planes;
+		clipped.push_back(plane);
+		voro::voronoicell_neighbor clippedCell;
+		return cutPlanes(clipped, center, boxMin, boxMax, clippedCell) ? (originalVolume - clippedCell.volume()) : originalVolume;
+	};
+	double budget = originalVolume * MAX_VOLUME_ERROR;
+	const float minArea = totalArea * _minFaceAreaFraction;
+	std::vector<Plane> groupPlanes(groups.size());
+	std::vector<double> groupCosts(groups.size(), 0.0);
+	std::vector<char> usesGroupPlane(groups.size(), 0);
+	std::vector<char> isSmall(groups.size(), 0);
+	for( size_t g = 0; g < groups.size(); ++g ) {
+		isSmall[g] = groups[g].area < minArea;
+		if( isSmall[g] ) {
+			continue;
+		}
+		groupPlanes[g] = planes[groups[g].plane];
+		if( groups[g].faces.size() < 2 || groups[g].weightedNormal.sqrMagnitude() <= 0.0f ) {
+			usesGroupPlane[g] = 1;
+			continue;
+		}
+		const Plane plane = replacementPlane(groups[g]);
+		const double cost = cutVolume(plane);
+		if( cost <= budget ) {
+			groupPlanes[g] = plane;
+			groupCosts[g] = cost;
+			usesGroupPlane[g] = 1;
+			budget -= cost;
+		}
+	}
+
+	// groups too small to matter join the merged group nearest in angle, rather than being dropped, as a dropped face would
+	// leave the cell free to grow past it into its neighbor.  those that would cut too much stay as they are.
+	for( size_t g = 0; g < groups.size(); ++g ) {
+		if( !isSmall[g] ) {
+			continue;
+		}
+		int nearest = -1;
+		for( size_t other = 0; other < groups.size(); ++other ) {
+			if( !usesGroupPlane[other] ) {
+				continue;
+			}
+			const float dot = planes[groups[other].plane].normal.dot(planes[groups[g].plane].normal);
+			if( nearest < 0 || dot > planes[groups[nearest].plane].normal.dot(planes[groups[g].plane].normal) ) {
+				nearest = static_cast<int>(other);
+			}
+		}
+		if( nearest < 0 ) {
+			continue;
+		}
+		Group joined = groups[nearest];
+		joined.area += groups[g].area;
+		joined.weightedNormal += groups[g].weightedNormal;
+		joined.faces.insert(joined.faces.end(), groups[g].faces.begin(), groups[g].faces.end());
+		const Plane plane = replacementPlane(joined);
+		const double cost = cutVolume(plane);
+		if( cost - groupCosts[nearest] <= budget ) {
+			budget -= cost - groupCosts[nearest];
+			groups[nearest] = joined;
+			groupPlanes[nearest] = plane;
+			groupCosts[nearest] = cost;
+			groups[g].faces.clear();
+		}
+	}
+
+	// faces of groups that could not be merged keep their own planes
+	std::vector<Plane> simplePlanes;
+	for( size_t g = 0; g < groups.size(); ++g ) {
+		if( usesGroupPlane[g] ) {
+			simplePlanes.push_back(groupPlanes[g]);
+			continue;
+		}
+		for( const size_t f : groups[g].faces ) {
+			simplePlanes.push_back(planes[faces[f].plane]);
+		}
+	}
+	if( simplePlanes.size() >= planes.size() ) {
+		return false;
+	}
+
+	// the simplified cell must still be closed and differ from the original by little volume.  the volume they share is
+	// measured too, so that volume gained in one place cannot hide volume lost in another.
+	voro::voronoicell_neighbor both;
+	std::vector<Plane> bothPlanes = planes;
+	bothPlanes.insert(bothPlanes.end(), simplePlanes.begin(), simplePlanes.end());
+	if( !cutPlanes(simplePlanes, center, boxMin, boxMax, vc) || !cutPlanes(bothPlanes, center, boxMin, boxMax, both) ) {
+		return false;
+	}
+	const double differentVolume = originalVolume + vc.volume() - 2.0 * both.volume();
+	if( differentVolume > originalVolume * MAX_VOLUME_ERROR ) {
+		return false;
+	}
+	vc.neighbors(neighbors);
+	vc.face_vertices(faceVertices);
+	for( const int id : neighbors ) {
+		if( id < 0 ) {
+			return false;
+		}
+	}
+
+	outCell.clear();
+	for( const int id : neighbors ) {
+		outCell.addPlane(simplePlanes[id]);
+	}
+	for( int i = 0; i < vc.p; ++i ) {
+		outCell.addVertex(center + cc::Vec3f(static_cast<float>(0.5 * vc.pts[3*i]), static_cast<float>(0.5 * vc.pts[3*i+1]), static_cast<float>(0.5 * vc.pts[3*i+2])));
+	}
+	for( size_t i = 0; i < faceVertices.size(); ) {
+		const int vertsInFace = faceVertices[i];
+		outCell.addFace(&faceVertices[i+1], vertsInFace);
+		i += vertsInFace + 1;
+	}
+	return true;
+}
+
+ICellGen::CellVisitor CellSimplifier::wrap( const ICellGen::CellVisitor& visitor ) const {
+	if( !isEnabled() ) {
+		return visitor;
+	}
+	return [this, visitor]( int id, const Cell& cell ) {
+		// the visitor may be called from many threads, so each keeps its own simplified cell
+		static thread_local Cell simplified;
+		if( simplify(cell, simplified) ) {
+			visitor(id, simplified);
+		} else {
+			visitor(id, cell);
+		}
+	};
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef __cell_simplifier__
+#define __cell_simplifier__
+
+#include <vector>
+#include <Plane.hpp>
+#include "Cell.hpp"
+#include "CellGenInfo.hpp"
+#include "ICellGen.hpp"
+
+// simplifies generated cells before they are sliced.  planes that do not bound the cell are dropped, planes whose normals
+// are within an angle of each other are merged into one, and planes whose faces are a tiny part of the cell's surface
+// are merged into the plane nearest in angle.  merged planes are moved in to the innermost corner of the faces they
+// replace, so the result lies within the original and never overlaps a neighboring cell.  merges are only made while the
+// volume they cut from the original stays small, and faces that cannot be merged keep their own planes.
+class CellSimplifier {
+public:
+	/**
+	 * Constructs a simplifier using the simplification settings of a CellGenInfo.
+	 * @param[in] info Info holding the merge angle and minimum face area.
+	 */
+	CellSimplifier( const CellGenInfo& info );
+
+	/**
+	 * Whether any simplification is asked for.
+	 * @returns True if cells will be simplified; false otherwise.
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * Simplifies a cell.  The cell must have both its planes and its faces.
+	 * @param[in]  cell    Cell to simplify.
+	 * @param[out] outCell Simplified Cell, with planes and faces.
+	 * @returns True if the cell was simplified; false if it should be used as-is.
+	 */
+	bool simplify( const Cell& cell, Cell& outCell ) const;
+
+	/**
+	 * Wraps a visitor so that it receives simplified cells, falling back to the original cell where simplification fails.
+	 * The simplifier must outlive the returned visitor.
+	 * @param[in] visitor Visitor to receive simplified cells.
+	 * @returns Wrapping visitor, or the given visitor if simplification is disabled.
+	 */
+	ICellGen::CellVisitor wrap( const ICellGen::CellVisitor& visitor ) const;
+
+private:
+	float _minFaceAreaFraction;
+	float _minMergeDot;
+};
+
+#endif /* __cell_simplifier__ */
\ No newline at end of file
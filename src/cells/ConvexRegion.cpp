@@ -0,0 +1,151 @@
+#include "ConvexRegion.hpp"
+#include <algorithm>
+#include <cmath>
+
+// distance from a splitting plane within which a vertex is considered to be on it
+static const float SPLIT_EPSILON = 0.00001f;
+
+ConvexRegion::ConvexRegion() {
+}
+
+ConvexRegion ConvexRegion::box( const cc::Vec3f& min, const cc::Vec3f& max ) {
+	const cc::Vec3f corners[8] = {
+		cc::Vec3f(min.x, min.y, min.z), cc::Vec3f(max.x, min.y, min.z), cc::Vec3f(max.x, max.y, min.z), cc::Vec3f(min.x, max.y, min.z),
+		cc::Vec3f(min.x, min.y, max.z), cc::Vec3f(max.x, min.y, max.z), cc::Vec3f(max.x, max.y, max.z), cc::Vec3f(min.x, max.y, max.z)
+	};
+	const int quads[6][4] = {{0, 3, 2, 1}, {4, 5, 6, 7}, {0, 1, 5, 4}, {2, 3, 7, 6}, {0, 4, 7, 3}, {1, 2, 6, 5}};
+	ConvexRegion region;
+	for( const auto& quad : quads ) {
+		region._faces.push_back({corners[quad[0]], corners[quad[1]], corners[quad[2]], corners[quad[3]]});
+	}
+	return region;
+}
+
+bool ConvexRegion::split( const Plane& plane, ConvexRegion& outPositive, ConvexRegion& outNegative ) const {
+	std::vector<std::vector<cc::Vec3f>> positiveFaces;
+	std::vector<std::vector<cc::Vec3f>> negativeFaces;
+	std::vector<cc::Vec3f> capPoints;
+	bool anyPositive = false;
+	bool anyNegative = false;
+	for( const auto& face : _faces ) {
+		std::vector<cc::Vec3f> positive;
+		std::vector<cc::Vec3f> negative;
+		for( size_t i = 0; i < face.size(); ++i ) {
+			const cc::Vec3f& a = face[i];
+			const cc::Vec3f& b = face[(i+1) % face.size()];
+			const float da = plane.signedDistance(a);
+			const float db = plane.signedDistance(b);
+			anyPositive |= (da > SPLIT_EPSILON);
+			anyNegative |= (da < -SPLIT_EPSILON);
+			if( da >= -SPLIT_EPSILON ) {
+				positive.push_back(a);
+			}
+			if( da <= SPLIT_EPSILON ) {
+				negative.push_back(a);
+			}
+			if( fabsf(da) <= SPLIT_EPSILON ) {
+				capPoints.push_back(a);
+			} else if( (da > SPLIT_EPSILON && db < -SPLIT_EPSILON) || (da < -SPLIT_EPSILON && db > SPLIT_EPSILON) ) {
+				const cc::Vec3f crossing = a + (b - a) * (da / (da - db));
+				positive.push_back(crossing);
+				negative.push_back(crossing);
+				capPoints.push_back(crossing);
+			}
+		}
+		if( positive.size() >= 3 ) {
+			positiveFaces.push_back(positive);
+		}
+		if( negative.size() >= 3 ) {
+			negativeFaces.push_back(negative);
+		}
+	}
+	if( !anyPositive || !anyNegative ) {
+		return false;
+	}
+
+	// the cap is the convex polygon of the points where the plane crossed the region, ordered by angle around their center
+	cc::Vec3f capCenter;
+	for( const auto& pnt : capPoints ) {
+		capCenter += pnt;
+	}
+	capCenter /= static_cast<float>(capPoints.size());
+	const cc::Vec3f axisU = ((fabsf(plane.normal.x) < 0.9f) ? cc::Vec3f(1.0f, 0.0f, 0.0f) : cc::Vec3f(0.0f, 1.0f, 0.0f)).cross(plane.normal).normalized();
+	const cc::Vec3f axisV = plane.normal.cross(axisU);
+	std::vector<std::pair<float, cc::Vec3f>> angles;
+	for( const auto& pnt : capPoints ) {
+		const cc::Vec3f offset = pnt - capCenter;
+		angles.push_back(std::make_pair(atan2f(offset.dot(axisV), offset.dot(axisU)), pnt));
+	}
+	std::sort(angles.begin(), angles.end(), []( const std::pair<float, cc::Vec3f>& lhs, const std::pair<float, cc::Vec3f>& rhs ) {
+		return lhs.first < rhs.first;
+	});
+	std::vector<cc::Vec3f> cap;
+	for( const auto& entry : angles ) {
+		if( cap.empty() || (entry.second - cap.back()).sqrMagnitude() > SPLIT_EPSILON*SPLIT_EPSILON ) {
+			cap.push_back(entry.second);
+		}
+	}
+	while( cap.size() > 1 && (cap.front() - cap.back()).sqrMagnitude() <= SPLIT_EPSILON*SPLIT_EPSILON ) {
+		cap.pop_back();
+	}
+	// the cap winds counter-clockwise around the plane's normal, which faces out of the negative part and into the positive one
+	if( cap.size() >= 3 ) {
+		positiveFaces.push_back(std::vector<cc::Vec3f>(cap.rbegin(), cap.rend()));
+		negativeFaces.push_back(cap);
+	}
+
+	outPositive._faces.swap(positiveFaces);
+	outPositive._planes = _planes;
+	outPositive._planes.push_back(plane);
+	outNegative._faces.swap(negativeFaces);
+	outNegative._planes = _planes;
+	outNegative._planes.push_back(plane.flipped());
+	return true;
+}
+
+bool ConvexRegion::clip( const Plane& plane ) {
+	ConvexRegion positive;
+	ConvexRegion negative;
+	if( split(plane, positive, negative) ) {
+		*this = std::move(positive);
+		return true;
+	}
+
+	// entirely on one side; nothing is left if that is the negative side
+	for( const auto& face : _faces ) {
+		for( const auto& pnt : face ) {
+			const float distance = plane.signedDistance(pnt);
+			if( distance > SPLIT_EPSILON ) {
+				return true;
+			}
+			if( distance < -SPLIT_EPSILON ) {
+				_faces.clear();
+				return false;
+			}
+		}
+	}
+	return !_faces.empty();
+}
+
+void ConvexRegion::toCell( const CellGenInfo& info, Cell& outCell ) const {
+	outCell.clear();
+	if( info.needsPlanes ) {
+		for( const auto& plane : _planes ) {
+			outCell.addPlane(plane);
+		}
+	}
+	if( info.needsFaces ) {
+		std::vector<int> indices;
+		for( const auto& face : _faces ) {
+			indices.clear();
+			for( const auto& pnt : face ) {
+				indices.push_back(outCell.addVertex(pnt));
+			}
+			outCell.addFace(indices.data(), static_cast<int>(indices.size()));
+		}
+	}
+}
+
+const std::vector<Plane>& ConvexRegion::getPlanes() const {
+	return _planes;
+}
\ No newline at end of file
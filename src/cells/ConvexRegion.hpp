@@ -0,0 +1,54 @@
+#ifndef __convex_region__
+#define __convex_region__
+
+#include <vector>
+#include <cc/Vec3.hpp>
+#include <Plane.hpp>
+#include "Cell.hpp"
+#include "CellGenInfo.hpp"
+
+// a convex region of space stored as its convex polygonal faces, along with the planes that cut it out of its original box.
+// used to build cells straight from planes without a voronoi diagram.
+class ConvexRegion {
+public:
+	ConvexRegion();
+
+	/**
+	 * Builds the region of an axis-aligned box.  The box's own faces are not added as planes.
+	 * @param[in] min Minimum corner of the box.
+	 * @param[in] max Maximum corner of the box.
+	 * @returns Region of the box.
+	 */
+	static ConvexRegion box( const cc::Vec3f& min, const cc::Vec3f& max );
+
+	/**
+	 * Splits the region by a plane into the parts on either side of it, capping both where the plane cut through.
+	 * @param[in]  plane       Plane to split by.
+	 * @param[out] outPositive Part on the positive side of the plane.
+	 * @param[out] outNegative Part on the negative side of the plane.
+	 * @returns True if the plane crosses the region; false (leaving the outputs untouched) otherwise.
+	 */
+	bool split( const Plane& plane, ConvexRegion& outPositive, ConvexRegion& outNegative ) const;
+
+	/**
+	 * Keeps only the part of the region on the positive side of a plane.
+	 * @param[in] plane Plane to clip by.
+	 * @returns False if nothing of the region is left; true otherwise.
+	 */
+	bool clip( const Plane& plane );
+
+	/**
+	 * Converts the region to a cell, with only the parts of the cell that info asks for.
+	 * @param[in]  info    Info stating which parts of the cell are needed.
+	 * @param[out] outCell Cell of the region.
+	 */
+	void toCell( const CellGenInfo& info, Cell& outCell ) const;
+
+	const std::vector<Plane>& getPlanes() const;
+
+private:
+	std::vector<std::vector<cc::Vec3f>> _faces;
+	std::vector<Plane> _planes;
+};
+
+#endif /* __convex_region__ */
\ No newline at end of file
@@ -2,12 +2,26 @@
 #define __iplanegenerator__
 
 #include <vector>
+#include <functional>
+#include <mutex>
+#include <algorithm>
 #include <cc/Vec3.hpp>
 #include <Plane.hpp>
 #include <BoundingBox.hpp>
 #include "Cell.hpp"
+#include "CellGenInfo.hpp"
 
 class ICellGen {
+public:
+	/**
+	 * Receives each generated cell.  The Cell is a view onto buffers owned by the generator that are reused for
+	 * the next cell, so it is only valid for the duration of the call.  When more than one thread is used for
+	 * generation, the visitor is invoked concurrently from each of them.
+	 * @param[in] id   Index of the sample point that seeded the cell.
+	 * @param[in] cell Generated cutting Cell.
+	 */
+	typedef std::function<void( int id, const Cell& cell )> CellVisitor;
+
 public:
 	ICellGen() {
 	}
@@ -15,13 +29,43 @@ public:
 	}
 
 	/**
-	 * Generates a list of cutting cells.
+	 * Generates cutting cells one at a time, handing each to a visitor as soon as it is computed.
+	 * @param[in] bbox         BoundingBox to clamp cell generation to.
+	 * @param[in] samplePoints Sample points used to seed cell generation.
+	 * @param[in] info         Info to be used for generation.
+	 * @param[in] visitor      Visitor to invoke for each generated Cell.
+	 * @returns True if any cells were generated; false otherwise.
+	 */
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const=0;
+
+	/**
+	 * Generates a list of cutting cells, ordered by the sample point that seeded them.
 	 * @param[in] bbox         BoundingBox to clamp cell generation to.
 	 * @param[in] samplePoints Sample points used to seed cell generation.
+	 * @param[in] info         Info to be used for generation.
 	 * @param[out] outCells    Vector of generated cutting Cells.
 	 * @returns True upon success; false otherwise.
 	 */
-	virtual bool generate( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, std::vector<Cell>& outCells ) const=0;
+	bool generate( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, std::vector<Cell>& outCells ) const {
+		outCells.clear();
+
+		std::mutex cellsMutex;
+		std::vector<std::pair<int, Cell>> idCells;
+		generateEach(bbox, samplePoints, info, [&]( int id, const Cell& cell ) {
+			std::lock_guard<std::mutex> lk(cellsMutex);
+			idCells.push_back(std::make_pair(id, cell));
+		});
+
+		// order by id so that the output does not depend on the number of threads
+		std::sort(idCells.begin(), idCells.end(), []( const std::pair<int, Cell>& lhs, const std::pair<int, Cell>& rhs ) {
+			return lhs.first < rhs.first;
+		});
+		outCells.reserve(idCells.size());
+		for( auto& entry : idCells ) {
+			outCells.push_back(std::move(entry.second));
+		}
+		return !outCells.empty();
+	}
 };
 
 #endif /* __iplanegenerator__ */
\ No newline at end of file
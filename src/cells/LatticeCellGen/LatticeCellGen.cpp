@@ -0,0 +1,201 @@
+#include "LatticeCellGen.hpp"
+#include <cells/ConvexRegion.hpp>
+#include <ParallelFor.hpp>
+#include <Random.hpp>
+
+// kinds of jittered planes, so that each has its own random sequence
+enum class LatticePlane {
+	Layer,
+	Row,
+	Joint,
+	HexLayer
+};
+
+// seed of a lattice plane from its kind and position in the lattice
+static unsigned int latticeSeed( LatticePlane kind, int a, int b, int c ) {
+	unsigned int hash = static_cast<unsigned int>(kind) * 0x9e3779b9u;
+	hash = (hash ^ static_cast<unsigned int>(a)) * 0x85ebca6bu;
+	hash = (hash ^ static_cast<unsigned int>(b)) * 0xc2b2ae35u;
+	hash = (hash ^ static_cast<unsigned int>(c)) * 0x27d4eb2fu;
+	return hash ^ (hash >> 15);
+}
+
+// builds a plane facing along axis through point, moved along the axis and tilted toward the other axes at random.  a plane
+// moves by at most a quarter of the spacing times the jitter, and tilts by at most as much again across the span of its
+// region along each other axis, so neighboring planes cannot cross within their region while the jitter is at most 1.
+static Plane jitteredPlane( int axis, const cc::Vec3f& point, const cc::Vec3f& spans, float spacing, float jitter, unsigned int seed ) {
+	cc::Vec3f normal(0.0f, 0.0f, 0.0f);
+	cc::Vec3f pointOnPlane = point;
+	if( jitter > 0.0f ) {
+		Random<float, int> rnd(seed);
+		const float reach = 0.25f * jitter * spacing;
+		const float offset = rnd.nextReal(-reach, reach);
+		const float slopes[3] = {rnd.nextReal(-reach, reach) / spans.x, rnd.nextReal(-reach, reach) / spans.y, rnd.nextReal(-reach, reach) / spans.z};
+		normal = cc::Vec3f(slopes[0], slopes[1], slopes[2]);
+		(&pointOnPlane.x)[axis] += offset;
+	}
+	(&normal.x)[axis] = 1.0f;
+	Plane plane = Plane::constructFromPointNormal(pointOnPlane, normal);
+	plane.pointOnPlane = pointOnPlane;
+	return plane;
+}
+
+LatticeCellGen::LatticeCellGen( Layout layout )
+	: ICellGen(), _layout(layout) {
+}
+
+LatticeCellGen::~LatticeCellGen() {
+}
+
+bool LatticeCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	// cells start as a box slightly larger than the bounding box, so that the outermost cells need no planes on the outside
+	const float EXP = 0.1f;
+	const cc::Vec3f boxMin(bbox.minX()-EXP, bbox.minY()-EXP, bbox.minZ()-EXP);
+	const cc::Vec3f boxMax(bbox.maxX()+EXP, bbox.maxY()+EXP, bbox.maxZ()+EXP);
+	const cc::Vec3f min(bbox.minX(), bbox.minY(), bbox.minZ());
+	const cc::Vec3f size = bbox.getHalfExtents() * 2.0f;
+	if( size.x <= 0.0f || size.y <= 0.0f || size.z <= 0.0f ) {
+		return false;
+	}
+	const int countX = std::max<int>(1, static_cast<int>(info.latticeCounts[0]));
+	const int countY = std::max<int>(1, static_cast<int>(info.latticeCounts[1]));
+	const int countZ = std::max<int>(1, static_cast<int>(info.latticeCounts[2]));
+	const float jitter = static_cast<float>(cc::math::clamp<double>(info.latticeJitter * 0.01, 0.0, 1.0));
+
+	std::atomic<int> cellCount(0);
+	const auto emit = [&]( int id, const std::vector<Plane>& planes, Cell& scratch ) {
+		ConvexRegion region = ConvexRegion::box(boxMin, boxMax);
+		for( const auto& plane : planes ) {
+			if( !region.clip(plane) ) {
+				return;
+			}
+		}
+		region.toCell(info, scratch);
+		++cellCount;
+		visitor(id, scratch);
+	};
+
+	if( Layout::Hex == _layout ) {
+		// flat-topped hexagons whose columns are 1.5 radii apart, with every other column shifted up by half a hexagon
+		const float radius = size.x / (1.5f * static_cast<float>(countX));
+		const float height = 1.73205081f * radius;
+		const int rowCount = static_cast<int>(ceilf(size.y / height)) + 1;
+		struct Column {
+			int i;
+			int j;
+			cc::Vec3f center;
+		};
+		std::vector<Column> columns;
+		for( int i = -1; i <= countX + 1; ++i ) {
+			for( int j = -1; j <= rowCount; ++j ) {
+				Column column;
+				column.i = i;
+				column.j = j;
+				column.center = cc::Vec3f(min.x + 1.5f * radius * i, min.y + height * (j + ((i & 1) ? 0.5f : 0.0f)), min.z + 0.5f * size.z);
+				if( column.center.x - radius >= boxMax.x || column.center.x + radius <= boxMin.x ||
+				    column.center.y - 0.5f * height >= boxMax.y || column.center.y + 0.5f * height <= boxMin.y ) {
+					continue;
+				}
+				columns.push_back(column);
+			}
+		}
+
+		const float layerHeight = size.z / static_cast<float>(countZ);
+		const cc::Vec3f layerSpans(2.0f * radius, height, layerHeight);
+		parallelFor(info.threadCount, static_cast<int>(columns.size()), [&]( int c ) {
+			const Column& column = columns[c];
+			Cell scratch;
+			std::vector<Plane> planes;
+			for( int k = 0; k < countZ; ++k ) {
+				// six sides, each facing inward from halfway to the neighboring column
+				planes.clear();
+				for( int side = 0; side < 6; ++side ) {
+					const float angle = 0.52359878f + 1.04719755f * side;
+					const cc::Vec3f outward(cosf(angle), sinf(angle), 0.0f);
+					const cc::Vec3f pointOnPlane = column.center + outward * (0.5f * height);
+					Plane plane = Plane::constructFromPointNormal(pointOnPlane, outward * -1.0f);
+					plane.pointOnPlane = pointOnPlane;
+					planes.push_back(plane);
+				}
+				// layers are only shared by the cells of this column
+				if( k > 0 ) {
+					const cc::Vec3f point(column.center.x, column.center.y, min.z + layerHeight * k);
+					planes.push_back(jitteredPlane(2, point, layerSpans, layerHeight, jitter, latticeSeed(LatticePlane::HexLayer, column.i, column.j, k)));
+				}
+				if( k + 1 < countZ ) {
+					const cc::Vec3f point(column.center.x, column.center.y, min.z + layerHeight * (k+1));
+					planes.push_back(jitteredPlane(2, point, layerSpans, layerHeight, jitter, latticeSeed(LatticePlane::HexLayer, column.i, column.j, k+1)).flipped());
+				}
+				emit(c * countZ + k, planes, scratch);
+			}
+		});
+		return cellCount > 0;
+	}
+
+	// layers along z, rows along y within each layer, and cells along x within each row
+	const cc::Vec3f spacing(size.x / static_cast<float>(countX), size.y / static_cast<float>(countY), size.z / static_cast<float>(countZ));
+	const auto layerPlane = [&]( int k ) {
+		const cc::Vec3f point(min.x + 0.5f * size.x, min.y + 0.5f * size.y, min.z + spacing.z * k);
+		return jitteredPlane(2, point, size, spacing.z, jitter, latticeSeed(LatticePlane::Layer, k, 0, 0));
+	};
+	const auto rowPlane = [&]( int k, int j ) {
+		const cc::Vec3f point(min.x + 0.5f * size.x, min.y + spacing.y * j, min.z + spacing.z * (k + 0.5f));
+		return jitteredPlane(1, point, cc::Vec3f(size.x, spacing.y, spacing.z), spacing.y, jitter, latticeSeed(LatticePlane::Row, k, j, 0));
+	};
+
+	// bricks in every other row (alternating between layers) are shifted by half a brick, so those rows have an extra cell
+	const auto rowStagger = [&]( int k, int j ) {
+		return (Layout::Brick == _layout && ((j + k) & 1)) ? 0.5f : 0.0f;
+	};
+	const auto rowCellCount = [&]( int k, int j ) {
+		return (rowStagger(k, j) > 0.0f) ? countX + 1 : countX;
+	};
+	std::vector<int> rowStarts(countZ * countY + 1, 0);
+	for( int row = 0; row < countZ * countY; ++row ) {
+		rowStarts[row+1] = rowStarts[row] + rowCellCount(row / countY, row % countY);
+	}
+
+	parallelFor(info.threadCount, countZ * countY, [&]( int row ) {
+		const int k = row / countY;
+		const int j = row % countY;
+		const float stagger = rowStagger(k, j);
+		const int cellsInRow = rowCellCount(k, j);
+
+		// planes of the layer and the row, facing into the row
+		std::vector<Plane> rowPlanes;
+		if( k > 0 ) {
+			rowPlanes.push_back(layerPlane(k));
+		}
+		if( k + 1 < countZ ) {
+			rowPlanes.push_back(layerPlane(k+1).flipped());
+		}
+		if( j > 0 ) {
+			rowPlanes.push_back(rowPlane(k, j));
+		}
+		if( j + 1 < countY ) {
+			rowPlanes.push_back(rowPlane(k, j+1).flipped());
+		}
+
+		// joints between cells of the row, only shared by the two cells on either side
+		const cc::Vec3f jointSpans(spacing.x, spacing.y, spacing.z);
+		const auto jointPlane = [&]( int joint ) {
+			const float x = min.x + spacing.x * (static_cast<float>(joint) + 1.0f - stagger);
+			const cc::Vec3f point(x, min.y + spacing.y * (j + 0.5f), min.z + spacing.z * (k + 0.5f));
+			return jitteredPlane(0, point, jointSpans, spacing.x, jitter, latticeSeed(LatticePlane::Joint, k, j, joint));
+		};
+
+		Cell scratch;
+		std::vector<Plane> planes;
+		for( int c = 0; c < cellsInRow; ++c ) {
+			planes = rowPlanes;
+			if( c > 0 ) {
+				planes.push_back(jointPlane(c-1));
+			}
+			if( c + 1 < cellsInRow ) {
+				planes.push_back(jointPlane(c).flipped());
+			}
+			emit(rowStarts[row] + c, planes, scratch);
+		}
+	});
+	return cellCount > 0;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef __lattice_cell_generator__
+#define __lattice_cell_generator__
+
+#include <cells/ICellGen.hpp>
+
+/**
+ * Generates cells of a regular lattice spanning the bounding box in closed form rather than computing a voronoi diagram.
+ * CellGenInfo::latticeCounts gives the number of cells along each axis, and CellGenInfo::latticeJitter moves and tilts the
+ * planes between cells.  Grids and bricks are split into layers along z, each layer into rows along y, and each row into
+ * cells along x, so each plane only has to match the cells on either side of it and can be jittered on its own.  Bricks
+ * stagger every other row by half a brick.  Hexagonal prisms stand along z, are sized so that the x count of them span the
+ * bounding box, and have their layers jittered per prism.  Sample points are unused.
+ */
+class LatticeCellGen : public ICellGen {
+public:
+	enum class Layout {
+		Grid,
+		Brick,
+		Hex
+	};
+
+public:
+	LatticeCellGen( Layout layout );
+	~LatticeCellGen();
+
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+
+private:
+	Layout _layout;
+};
+
+#endif /* __lattice_cell_generator__ */
\ No newline at end of file
@@ -0,0 +1,188 @@
+#include "LloydRelaxer.hpp"
+#include <algorithm>
+#include <cmath>
+
+// barycentric weights of the four-point quadrature rule used to integrate density over each tetrahedron
+static const float QUADRATURE_A = 0.5854102f;
+static const float QUADRATURE_B = 0.1381966f;
+
+// number of nearest original points that the density at a position is measured from
+static const int DENSITY_NEIGHBORS = 8;
+
+// density of the sample points before relaxing, measured anywhere from the distance to the k-th nearest of them.  it varies
+// smoothly across cells, so weighting centroids by it keeps clustered points clustered rather than pulling them apart.
+class SeedDensity {
+public:
+	SeedDensity()
+		: _cellSize(1.0f) {
+		_res[0] = _res[1] = _res[2] = 0;
+	}
+
+	void build( const std::vector<cc::Vec3f>& points ) {
+		_points = points;
+		if( _points.empty() ) {
+			return;
+		}
+
+		// buckets of around one point each
+		cc::Vec3f max = _points.front();
+		_min = _points.front();
+		for( const auto& pnt : _points ) {
+			_min = cc::Vec3f(std::min<float>(_min.x, pnt.x), std::min<float>(_min.y, pnt.y), std::min<float>(_min.z, pnt.z));
+			max = cc::Vec3f(std::max<float>(max.x, pnt.x), std::max<float>(max.y, pnt.y), std::max<float>(max.z, pnt.z));
+		}
+		const cc::Vec3f extents = max - _min;
+		const float volume = std::max<float>(extents.x, 1e-6f) * std::max<float>(extents.y, 1e-6f) * std::max<float>(extents.z, 1e-6f);
+		_cellSize = std::max<float>(cbrtf(volume / static_cast<float>(_points.size())), 1e-6f);
+		_res[0] = std::max<int>(1, static_cast<int>(extents.x / _cellSize) + 1);
+		_res[1] = std::max<int>(1, static_cast<int>(extents.y / _cellSize) + 1);
+		_res[2] = std::max<int>(1, static_cast<int>(extents.z / _cellSize) + 1);
+		_buckets.assign(static_cast<size_t>(_res[0]) * _res[1] * _res[2], std::vector<int>());
+		for( size_t i = 0; i < _points.size(); ++i ) {
+			int x, y, z;
+			bucketOf(_points[i], x, y, z);
+			_buckets[bucketIndex(x, y, z)].push_back(static_cast<int>(i));
+		}
+	}
+
+	float densityAt( const cc::Vec3f& pos ) const {
+		// search rings of buckets outward until no closer point can be in the next ring, keeping the nearest few distances
+		const size_t k = std::min<size_t>(DENSITY_NEIGHBORS, _points.size());
+		std::vector<float> nearest; // max-heap of the k smallest squared distances
+		int cx, cy, cz;
+		bucketOf(pos, cx, cy, cz);
+		const int maxRing = std::max<int>(_res[0], std::max<int>(_res[1], _res[2]));
+		for( int ring = 0; ring <= maxRing; ++ring ) {
+			for( int z = cz-ring; z <= cz+ring; ++z ) {
+				for( int y = cy-ring; y <= cy+ring; ++y ) {
+					for( int x = cx-ring; x <= cx+ring; ++x ) {
+						const bool onRing = (abs(x-cx) == ring) || (abs(y-cy) == ring) || (abs(z-cz) == ring);
+						if( !onRing || x < 0 || y < 0 || z < 0 || x >= _res[0] || y >= _res[1] || z >= _res[2] ) {
+							continue;
+						}
+						for( const int idx : _buckets[bucketIndex(x, y, z)] ) {
+							const float sqrDistance = (_points[idx] - pos).sqrMagnitude();
+							if( nearest.size() < k ) {
+								nearest.push_back(sqrDistance);
+								std::push_heap(nearest.begin(), nearest.end());
+							} else if( sqrDistance < nearest.front() ) {
+								std::pop_heap(nearest.begin(), nearest.end());
+								nearest.back() = sqrDistance;
+								std::push_heap(nearest.begin(), nearest.end());
+							}
+						}
+					}
+				}
+			}
+			const float ringDistance = static_cast<float>(ring) * _cellSize;
+			if( nearest.size() == k && nearest.front() <= ringDistance * ringDistance ) {
+				break;
+			}
+		}
+
+		// k points within a ball of this radius (constant factors do not move centroids).  relaxed points end up spread by
+		// their weight to the power of 3/5, so the weight is the density to the power of 5/3 to keep the original spread.
+		const float radius = std::max<float>(sqrtf(nearest.front()), _cellSize * 0.001f);
+		return 1.0f / (radius * radius * radius * radius * radius);
+	}
+
+private:
+	void bucketOf( const cc::Vec3f& pos, int& x, int& y, int& z ) const {
+		x = std::min<int>(_res[0]-1, std::max<int>(0, static_cast<int>((pos.x - _min.x) / _cellSize)));
+		y = std::min<int>(_res[1]-1, std::max<int>(0, static_cast<int>((pos.y - _min.y) / _cellSize)));
+		z = std::min<int>(_res[2]-1, std::max<int>(0, static_cast<int>((pos.z - _min.z) / _cellSize)));
+	}
+
+	size_t bucketIndex( int x, int y, int z ) const {
+		return (static_cast<size_t>(z) * _res[1] + y) * _res[0] + x;
+	}
+
+private:
+	std::vector<cc::Vec3f> _points;
+	std::vector<std::vector<int>> _buckets;
+	cc::Vec3f _min;
+	float _cellSize;
+	int _res[3];
+};
+
+// computes the centroid of a cell's volume, weighted by density if given
+static bool computeWeightedCentroid( const Cell& cell, const SeedDensity* density, cc::Vec3f& outCentroid ) {
+	const std::vector<cc::Vec3f>& vertices = cell.getVertices();
+	if( vertices.empty() ) {
+		return false;
+	}
+
+	// split the cell into tetrahedra from an inner point to each triangle of each (convex) face
+	cc::Vec3f apex;
+	for( const auto& vtx : vertices ) {
+		apex += vtx;
+	}
+	apex /= static_cast<float>(vertices.size());
+
+	float volume = 0.0f;
+	float mass = 0.0f;
+	cc::Vec3f weightedCentroid;
+	for( unsigned int face = 0; face < cell.getFaceCount(); ++face ) {
+		const int faceSize = cell.getFaceSize(face);
+		const int* faceIndices = cell.getFaceIndices(face);
+		const cc::Vec3f& a = vertices[faceIndices[0]];
+		for( int i = 1; i + 1 < faceSize; ++i ) {
+			const cc::Vec3f& b = vertices[faceIndices[i]];
+			const cc::Vec3f& c = vertices[faceIndices[i+1]];
+			const float tetVolume = fabsf((a - apex).dot((b - apex).cross(c - apex))) / 6.0f;
+			volume += tetVolume;
+			if( nullptr == density ) {
+				mass += tetVolume;
+				weightedCentroid += (apex + a + b + c) * (0.25f * tetVolume);
+				continue;
+			}
+			const cc::Vec3f corners[4] = {apex, a, b, c};
+			for( int q = 0; q < 4; ++q ) {
+				const cc::Vec3f pnt = corners[q] * QUADRATURE_A + (corners[(q+1)%4] + corners[(q+2)%4] + corners[(q+3)%4]) * QUADRATURE_B;
+				const float pointMass = 0.25f * tetVolume * density->densityAt(pnt);
+				mass += pointMass;
+				weightedCentroid += pnt * pointMass;
+			}
+		}
+	}
+	if( volume <= 0.0f || mass <= 0.0f ) {
+		return false;
+	}
+	outCentroid = weightedCentroid / mass;
+	return true;
+}
+
+LloydRelaxer::LloydRelaxer( unsigned int iterations, bool preserveDensity )
+	: _iterations(iterations), _preserveDensity(preserveDensity) {
+}
+
+bool LloydRelaxer::relax( const ICellGen& gen, const BoundingBox& bbox, const CellGenInfo& info, std::vector<cc::Vec3f>& samplePoints ) const {
+	if( samplePoints.empty() ) {
+		return false;
+	}
+
+	// centroids only need faces
+	CellGenInfo relaxInfo = info;
+	relaxInfo.needsPlanes = false;
+	relaxInfo.needsFaces = true;
+
+	// density is measured from the points as they were generated, and stays put while they move
+	SeedDensity density;
+	if( _preserveDensity ) {
+		density.build(samplePoints);
+	}
+
+	std::vector<cc::Vec3f> centroids;
+	for( unsigned int i = 0; i < _iterations; ++i ) {
+		// ids are unique, so each centroid can be written straight into its slot from any thread.  points whose cells
+		// could not be computed stay where they are.
+		centroids = samplePoints;
+		if( !gen.generateEach(bbox, samplePoints, relaxInfo, [&]( int id, const Cell& cell ) {
+			computeWeightedCentroid(cell, _preserveDensity ? &density : nullptr, centroids[id]);
+		}) ) {
+			return false;
+		}
+		samplePoints.swap(centroids);
+	}
+	return true;
+}
\ No newline at end of file
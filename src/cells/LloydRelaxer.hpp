@@ -0,0 +1,40 @@
+#ifndef __lloyd_relaxer__
+#define __lloyd_relaxer__
+
+#include <vector>
+#include <cc/Vec3.hpp>
+#include <BoundingBox.hpp>
+#include "Cell.hpp"
+#include "CellGenInfo.hpp"
+#include "ICellGen.hpp"
+
+// moves sample points toward a centroidal voronoi tessellation, where each point is the centroid of its own cell.  cells
+// are made by the same generator (and weights) that will make the cutting cells, so relaxed cells are evenly shaped.
+// plain centroids flatten out any clusters of points, as they even out cells.  points that are meant to be clustered can
+// instead be moved to centroids weighted by their density before relaxing (measured from the distance to the nearest few of
+// them), which keeps the clusters.  this also keeps the random variation of evenly spread points, so it is not for those.
+class LloydRelaxer {
+public:
+	/**
+	 * Constructs a relaxer.
+	 * @param[in] iterations      Number of times to move every point to its cell's centroid.
+	 * @param[in] preserveDensity If true, centroids are weighted by the density of the points before relaxing.
+	 */
+	LloydRelaxer( unsigned int iterations, bool preserveDensity );
+
+	/**
+	 * Relaxes sample points.  Any per-point radii in info are kept with their points.
+	 * @param[in]     gen          Generator of the cells whose centroids the points are moved to.
+	 * @param[in]     bbox         BoundingBox to clamp cell generation to.
+	 * @param[in]     info         Info to be used for generation.
+	 * @param[in,out] samplePoints Sample points to relax.
+	 * @returns True upon success; false otherwise.
+	 */
+	bool relax( const ICellGen& gen, const BoundingBox& bbox, const CellGenInfo& info, std::vector<cc::Vec3f>& samplePoints ) const;
+
+private:
+	unsigned int _iterations;
+	bool _preserveDensity;
+};
+
+#endif /* __lloyd_relaxer__ */
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "CellPattern.hpp"
+#include <fstream>
+#include <cells/VoroHelper.hpp>
+
+static const char PATTERN_MAGIC[4] = {'H', 'D', 'N', 'P'};
+static const uint32_t PATTERN_VERSION = 1;
+
+template<typename T>
+static void writeArray( std::ofstream& out, const std::vector<T>& values ) {
+	if( !values.empty() ) {
+		out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+	}
+}
+
+CellPattern::CellPattern()
+	: _header(nullptr), _cells(nullptr), _vertices(nullptr), _faceSizes(nullptr), _faceIndices(nullptr), _planes(nullptr) {
+}
+
+bool CellPattern::save( const std::string& path, const std::vector<cc::Vec3f>& seeds, const std::vector<float>& radii, const std::vector<Cell>& cells ) {
+	if( cells.size() != seeds.size() ) {
+		return false;
+	}
+
+	std::vector<CellRecord> cellRecords;
+	std::vector<float> vertices;
+	std::vector<uint32_t> faceSizes;
+	std::vector<uint32_t> faceIndices;
+	std::vector<PlaneRecord> planes;
+	const cc::Vec3f period(1.0f, 1.0f, 1.0f);
+	for( size_t i = 0; i < cells.size(); ++i ) {
+		const Cell& cell = cells[i];
+
+		CellRecord record;
+		record.firstVertex = static_cast<uint32_t>(vertices.size() / 3);
+		record.vertexCount = static_cast<uint32_t>(cell.getVertices().size());
+		record.firstFace = static_cast<uint32_t>(faceSizes.size());
+		record.faceCount = cell.getFaceCount();
+		record.firstFaceIndex = static_cast<uint32_t>(faceIndices.size());
+		record.firstPlane = static_cast<uint32_t>(planes.size());
+		record.planeCount = cell.getPlaneCount();
+		cellRecords.push_back(record);
+
+		for( const auto& vtx : cell.getVertices() ) {
+			vertices.push_back(vtx.x);
+			vertices.push_back(vtx.y);
+			vertices.push_back(vtx.z);
+		}
+		for( unsigned int face = 0; face < cell.getFaceCount(); ++face ) {
+			const int faceSize = cell.getFaceSize(face);
+			faceSizes.push_back(static_cast<uint32_t>(faceSize));
+			faceIndices.insert(faceIndices.end(), cell.getFaceIndices(face), cell.getFaceIndices(face) + faceSize);
+		}
+
+		const float seedRadius = radii.empty() ? 0.0f : radii[i];
+		for( const auto& plane : cell.getPlanes() ) {
+			PlaneRecord planeRecord;
+			planeRecord.normal[0] = plane.normal.x;
+			planeRecord.normal[1] = plane.normal.y;
+			planeRecord.normal[2] = plane.normal.z;
+			planeRecord.pointOnPlane[0] = plane.pointOnPlane.x;
+			planeRecord.pointOnPlane[1] = plane.pointOnPlane.y;
+			planeRecord.pointOnPlane[2] = plane.pointOnPlane.z;
+			planeRecord.neighborId = plane.neighborId;
+			planeRecord.neighborTile[0] = planeRecord.neighborTile[1] = planeRecord.neighborTile[2] = 0;
+			planeRecord.padding = 0;
+			if( plane.neighborId >= 0 && plane.neighborId < static_cast<int>(seeds.size()) ) {
+				// find which copy of the neighbor the plane was built against
+				const float neighborRadius = radii.empty() ? 0.0f : radii[plane.neighborId];
+				int offset[3];
+				VoroHelper::periodicImage(period, seeds[i], seedRadius, seeds[plane.neighborId], neighborRadius, plane.pointOnPlane, offset);
+				planeRecord.neighborTile[0] = static_cast<int8_t>(offset[0]);
+				planeRecord.neighborTile[1] = static_cast<int8_t>(offset[1]);
+				planeRecord.neighborTile[2] = static_cast<int8_t>(offset[2]);
+			}
+			planes.push_back(planeRecord);
+		}
+	}
+
+	Header header;
+	std::copy(PATTERN_MAGIC, PATTERN_MAGIC + 4, header.magic);
+	header.version = PATTERN_VERSION;
+	header.cellCount = static_cast<uint32_t>(cellRecords.size());
+	header.vertexCount = static_cast<uint32_t>(vertices.size() / 3);
+	header.faceCount = static_cast<uint32_t>(faceSizes.size());
+	header.faceIndexCount = static_cast<uint32_t>(faceIndices.size());
+	header.planeCount = static_cast<uint32_t>(planes.size());
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if( !out.is_open() ) {
+		return false;
+	}
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	writeArray(out, cellRecords);
+	writeArray(out, vertices);
+	writeArray(out, faceSizes);
+	writeArray(out, faceIndices);
+	writeArray(out, planes);
+	return out.good();
+}
+
+bool CellPattern::load( const std::string& path ) {
+	_header = nullptr;
+	if( !_file.open(path) || _file.getSize() < sizeof(Header) ) {
+		return false;
+	}
+
+	const unsigned char* data = _file.getData();
+	const Header* header = reinterpret_cast<const Header*>(data);
+	if( !std::equal(PATTERN_MAGIC, PATTERN_MAGIC + 4, header->magic) || header->version != PATTERN_VERSION ) {
+		return false;
+	}
+
+	// every section is a multiple of four bytes, so all of them stay aligned within the mapping
+	const size_t cellsOffset = sizeof(Header);
+	const size_t verticesOffset = cellsOffset + sizeof(CellRecord) * header->cellCount;
+	const size_t faceSizesOffset = verticesOffset + sizeof(float) * 3 * header->vertexCount;
+	const size_t faceIndicesOffset = faceSizesOffset + sizeof(uint32_t) * header->faceCount;
+	const size_t planesOffset = faceIndicesOffset + sizeof(uint32_t) * header->faceIndexCount;
+	const size_t totalSize = planesOffset + sizeof(PlaneRecord) * header->planeCount;
+	if( _file.getSize() < totalSize ) {
+		return false;
+	}
+
+	_cells = reinterpret_cast<const CellRecord*>(data + cellsOffset);
+	_vertices = reinterpret_cast<const float*>(data + verticesOffset);
+	_faceSizes = reinterpret_cast<const uint32_t*>(data + faceSizesOffset);
+	_faceIndices = reinterpret_cast<const uint32_t*>(data + faceIndicesOffset);
+	_planes = reinterpret_cast<const PlaneRecord*>(data + planesOffset);
+
+	// validate that cells only reference data within the file
+	for( uint32_t i = 0; i < header->cellCount; ++i ) {
+		const CellRecord& cell = _cells[i];
+		if( cell.firstVertex + cell.vertexCount > header->vertexCount || cell.firstFace + cell.faceCount > header->faceCount || cell.firstPlane + cell.planeCount > header->planeCount ) {
+			return false;
+		}
+		uint32_t faceIndexCount = 0;
+		for( uint32_t face = 0; face < cell.faceCount; ++face ) {
+			faceIndexCount += _faceSizes[cell.firstFace + face];
+		}
+		if( cell.firstFaceIndex + faceIndexCount > header->faceIndexCount ) {
+			return false;
+		}
+		for( uint32_t idx = 0; idx < faceIndexCount; ++idx ) {
+			if( _faceIndices[cell.firstFaceIndex + idx] >= cell.vertexCount ) {
+				return false;
+			}
+		}
+	}
+
+	_header = header;
+	return true;
+}
+
+uint32_t CellPattern::getCellCount() const {
+	return (_header != nullptr) ? _header->cellCount : 0;
+}
+
+const CellPattern::CellRecord& CellPattern::getCell( uint32_t cell ) const {
+	return _cells[cell];
+}
+
+cc::Vec3f CellPattern::getVertex( uint32_t vertex ) const {
+	return cc::Vec3f(_vertices[3*vertex], _vertices[3*vertex+1], _vertices[3*vertex+2]);
+}
+
+uint32_t CellPattern::getFaceSize( uint32_t face ) const {
+	return _faceSizes[face];
+}
+
+const uint32_t* CellPattern::getFaceIndices() const {
+	return _faceIndices;
+}
+
+const CellPattern::PlaneRecord& CellPattern::getPlane( uint32_t plane ) const {
+	return _planes[plane];
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef __cell_pattern__
+#define __cell_pattern__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cc/Vec3.hpp>
+#include <MappedFile.hpp>
+#include "../Cell.hpp"
+
+// a precomputed pattern of cells over the unit cube that wrap around its sides so that copies of it tile space.
+// patterns are stored as a compact (little endian) binary file that is memory mapped and read in place:
+//    Header
+//    CellRecord[cellCount]    one per seed; cells whose seed produced no cell are empty
+//    float[3][vertexCount]    cell vertices
+//    uint32[faceCount]        number of vertices in each face
+//    uint32[faceIndexCount]   vertex indices of each face, relative to the cell's first vertex
+//    PlaneRecord[planeCount]  cell planes
+class CellPattern {
+public:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t cellCount;
+		uint32_t vertexCount;
+		uint32_t faceCount;
+		uint32_t faceIndexCount;
+		uint32_t planeCount;
+	};
+
+	struct CellRecord {
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		uint32_t firstFace;
+		uint32_t faceCount;
+		uint32_t firstFaceIndex;
+		uint32_t firstPlane;
+		uint32_t planeCount;
+	};
+
+	struct PlaneRecord {
+		float normal[3];
+		float pointOnPlane[3];
+		int32_t neighborId; // cell across the plane
+		int8_t neighborTile[3]; // which copy of the pattern (-1, 0, or +1 along each axis) that cell is in
+		int8_t padding;
+	};
+
+public:
+	CellPattern();
+
+	/**
+	 * Writes a pattern file.
+	 * @param[in] path  Path of the file to write.
+	 * @param[in] seeds Seeds that the cells were generated from, within the unit cube.
+	 * @param[in] radii Radii of the seeds if the cells are weighted; empty otherwise.
+	 * @param[in] cells Periodic cells of the seeds, indexed by seed.
+	 * @returns True upon success; false otherwise.
+	 */
+	static bool save( const std::string& path, const std::vector<cc::Vec3f>& seeds, const std::vector<float>& radii, const std::vector<Cell>& cells );
+
+	/**
+	 * Maps a pattern file for reading.
+	 * @param[in] path Path of the file to read.
+	 * @returns True if the file is a valid pattern; false otherwise.
+	 */
+	bool load( const std::string& path );
+
+	uint32_t getCellCount() const;
+	const CellRecord& getCell( uint32_t cell ) const;
+	cc::Vec3f getVertex( uint32_t vertex ) const;
+	uint32_t getFaceSize( uint32_t face ) const;
+	const uint32_t* getFaceIndices() const;
+	const PlaneRecord& getPlane( uint32_t plane ) const;
+
+private:
+	MappedFile _file;
+	const Header* _header;
+	const CellRecord* _cells;
+	const float* _vertices;
+	const uint32_t* _faceSizes;
+	const uint32_t* _faceIndices;
+	const PlaneRecord* _planes;
+};
+
+#endif /* __cell_pattern__ */
\ No newline at end of file
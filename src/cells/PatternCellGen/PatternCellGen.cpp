@@ -0,0 +1,189 @@
+#include "PatternCellGen.hpp"
+#include "CellPattern.hpp"
+#include "../../MTLog.hpp"
+#include <ParallelFor.hpp>
+#include <cmath>
+#include <atomic>
+
+// maps the pattern's space onto the bounding box: world = center + rotation * (scale * (pattern - origin))
+struct PatternTransform {
+	cc::Vec3f center;
+	cc::Vec3f scale;
+	cc::Vec3f origin;
+	cc::Vec3f rows[3]; // rotation matrix
+
+	cc::Vec3f rotate( const cc::Vec3f& v ) const {
+		return cc::Vec3f(rows[0].dot(v), rows[1].dot(v), rows[2].dot(v));
+	}
+
+	cc::Vec3f inverseRotate( const cc::Vec3f& v ) const {
+		return rows[0] * v.x + rows[1] * v.y + rows[2] * v.z;
+	}
+
+	cc::Vec3f toWorld( const cc::Vec3f& point ) const {
+		const cc::Vec3f local = point - origin;
+		return center + rotate(cc::Vec3f(local.x * scale.x, local.y * scale.y, local.z * scale.z));
+	}
+
+	cc::Vec3f toPattern( const cc::Vec3f& point ) const {
+		const cc::Vec3f local = inverseRotate(point - center);
+		return origin + cc::Vec3f(local.x / scale.x, local.y / scale.y, local.z / scale.z);
+	}
+
+	// normals transform by the inverse transpose, which for rotation * scale is rotation * scale^-1
+	cc::Vec3f normalToWorld( const cc::Vec3f& normal ) const {
+		return rotate(cc::Vec3f(normal.x / scale.x, normal.y / scale.y, normal.z / scale.z)).normalized();
+	}
+};
+
+// builds a rotation matrix from euler angles in degrees, applied in x, y, z order
+static void eulerToRows( const cc::Vec3f& degrees, cc::Vec3f rows[3] ) {
+	const float DEG_TO_RAD = 0.0174532925f;
+	const float cx = cosf(degrees.x * DEG_TO_RAD);
+	const float sx = sinf(degrees.x * DEG_TO_RAD);
+	const float cy = cosf(degrees.y * DEG_TO_RAD);
+	const float sy = sinf(degrees.y * DEG_TO_RAD);
+	const float cz = cosf(degrees.z * DEG_TO_RAD);
+	const float sz = sinf(degrees.z * DEG_TO_RAD);
+	rows[0] = cc::Vec3f(cy*cz, sx*sy*cz - cx*sz, cx*sy*cz + sx*sz);
+	rows[1] = cc::Vec3f(cy*sz, sx*sy*sz + cx*cz, cx*sy*sz - sx*cz);
+	rows[2] = cc::Vec3f(-sy, sx*cy, cx*cy);
+}
+
+PatternCellGen::PatternCellGen()
+	: ICellGen() {
+}
+
+PatternCellGen::~PatternCellGen() {
+}
+
+bool PatternCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	CellPattern pattern;
+	if( !pattern.load(info.patternPath) ) {
+		MTLog::instance()->log("Error: Failed to load cell pattern " + info.patternPath + ".\n");
+		return false;
+	}
+	const int cellCount = static_cast<int>(pattern.getCellCount());
+	if( 0 == cellCount ) {
+		return false;
+	}
+
+	// patternTiles copies of the unit cube span the bounding box along each axis, centered on it
+	const float tiles = static_cast<float>(std::max<unsigned int>(1, info.patternTiles));
+	const cc::Vec3f size = bbox.getHalfExtents() * 2.0f;
+	PatternTransform transform;
+	transform.center = bbox.getCenter();
+	transform.scale = cc::Vec3f(std::max<float>(size.x, 1e-6f), std::max<float>(size.y, 1e-6f), std::max<float>(size.z, 1e-6f)) * (1.0f / tiles);
+	transform.origin = cc::Vec3f(tiles * 0.5f);
+	eulerToRows(info.patternRotation, transform.rows);
+
+	// find the range of copies that can touch the bounding box.  cells reach a little past their own copy, so pad by one.
+	cc::Vec3f patternMin(std::numeric_limits<float>::max());
+	cc::Vec3f patternMax(-std::numeric_limits<float>::max());
+	for( int corner = 0; corner < 8; ++corner ) {
+		const cc::Vec3f world((corner & 1) ? bbox.maxX() : bbox.minX(), (corner & 2) ? bbox.maxY() : bbox.minY(), (corner & 4) ? bbox.maxZ() : bbox.minZ());
+		const cc::Vec3f pnt = transform.toPattern(world);
+		patternMin.x = std::min<float>(patternMin.x, pnt.x);
+		patternMin.y = std::min<float>(patternMin.y, pnt.y);
+		patternMin.z = std::min<float>(patternMin.z, pnt.z);
+		patternMax.x = std::max<float>(patternMax.x, pnt.x);
+		patternMax.y = std::max<float>(patternMax.y, pnt.y);
+		patternMax.z = std::max<float>(patternMax.z, pnt.z);
+	}
+	const int tileMin[3] = {static_cast<int>(floorf(patternMin.x)) - 1, static_cast<int>(floorf(patternMin.y)) - 1, static_cast<int>(floorf(patternMin.z)) - 1};
+	const int tileCount[3] = {static_cast<int>(floorf(patternMax.x)) + 2 - tileMin[0], static_cast<int>(floorf(patternMax.y)) + 2 - tileMin[1], static_cast<int>(floorf(patternMax.z)) + 2 - tileMin[2]};
+	const int totalTiles = tileCount[0] * tileCount[1] * tileCount[2];
+
+	// index of a copy within the range, or -1 if outside of it
+	const auto tileIndex = [&]( int x, int y, int z ) {
+		x -= tileMin[0];
+		y -= tileMin[1];
+		z -= tileMin[2];
+		if( x < 0 || y < 0 || z < 0 || x >= tileCount[0] || y >= tileCount[1] || z >= tileCount[2] ) {
+			return -1;
+		}
+		return x + tileCount[0] * (y + tileCount[1] * z);
+	};
+
+	// emits every cell of every copy in [first, last) that overlaps the bounding box
+	std::atomic<int> emittedCount(0);
+	const float EPSILON = 1e-4f;
+	const auto emitRange = [&]( int first, int last ) {
+		Cell outCell;
+		std::vector<cc::Vec3f> vertices;
+		std::vector<int> faceIndices;
+		for( int item = first; item < last; ++item ) {
+			const int tile = item / cellCount;
+			const int cellId = item % cellCount;
+			const int tx = tileMin[0] + tile % tileCount[0];
+			const int ty = tileMin[1] + (tile / tileCount[0]) % tileCount[1];
+			const int tz = tileMin[2] + tile / (tileCount[0] * tileCount[1]);
+			const cc::Vec3f tileOffset(static_cast<float>(tx), static_cast<float>(ty), static_cast<float>(tz));
+
+			const CellPattern::CellRecord& record = pattern.getCell(static_cast<uint32_t>(cellId));
+			if( 0 == record.vertexCount ) {
+				continue;
+			}
+
+			// transform the vertices and skip cells that miss (or only touch) the bounding box
+			vertices.clear();
+			cc::Vec3f cellMin(std::numeric_limits<float>::max());
+			cc::Vec3f cellMax(-std::numeric_limits<float>::max());
+			for( uint32_t v = 0; v < record.vertexCount; ++v ) {
+				const cc::Vec3f world = transform.toWorld(pattern.getVertex(record.firstVertex + v) + tileOffset);
+				vertices.push_back(world);
+				cellMin.x = std::min<float>(cellMin.x, world.x);
+				cellMin.y = std::min<float>(cellMin.y, world.y);
+				cellMin.z = std::min<float>(cellMin.z, world.z);
+				cellMax.x = std::max<float>(cellMax.x, world.x);
+				cellMax.y = std::max<float>(cellMax.y, world.y);
+				cellMax.z = std::max<float>(cellMax.z, world.z);
+			}
+			if( cellMax.x <= bbox.minX() + EPSILON || cellMin.x >= bbox.maxX() - EPSILON ||
+			    cellMax.y <= bbox.minY() + EPSILON || cellMin.y >= bbox.maxY() - EPSILON ||
+			    cellMax.z <= bbox.minZ() + EPSILON || cellMin.z >= bbox.maxZ() - EPSILON ) {
+				continue;
+			}
+
+			outCell.clear();
+			if( info.needsFaces ) {
+				for( const auto& vtx : vertices ) {
+					outCell.addVertex(vtx);
+				}
+				const uint32_t* indices = pattern.getFaceIndices() + record.firstFaceIndex;
+				for( uint32_t face = 0; face < record.faceCount; ++face ) {
+					const uint32_t faceSize = pattern.getFaceSize(record.firstFace + face);
+					faceIndices.assign(indices, indices + faceSize);
+					outCell.addFace(faceIndices.data(), static_cast<int>(faceSize));
+					indices += faceSize;
+				}
+			}
+			if( info.needsPlanes ) {
+				for( uint32_t p = 0; p < record.planeCount; ++p ) {
+					const CellPattern::PlaneRecord& planeRecord = pattern.getPlane(record.firstPlane + p);
+					const cc::Vec3f normal(planeRecord.normal[0], planeRecord.normal[1], planeRecord.normal[2]);
+					const cc::Vec3f pointOnPlane = transform.toWorld(cc::Vec3f(planeRecord.pointOnPlane[0], planeRecord.pointOnPlane[1], planeRecord.pointOnPlane[2]) + tileOffset);
+					Plane plane = Plane::constructFromPointNormal(pointOnPlane, transform.normalToWorld(normal));
+					plane.pointOnPlane = pointOnPlane;
+					const int neighborTile = tileIndex(tx + planeRecord.neighborTile[0], ty + planeRecord.neighborTile[1], tz + planeRecord.neighborTile[2]);
+					plane.neighborId = (planeRecord.neighborId >= 0 && neighborTile >= 0) ? (neighborTile * cellCount + planeRecord.neighborId) : Plane::NO_NEIGHBOR;
+					outCell.addPlane(plane);
+				}
+			}
+
+			++emittedCount;
+			visitor(tile * cellCount + cellId, outCell);
+		}
+	};
+
+	// split the (copy, cell) pairs into contiguous ranges, one per thread
+	const int itemCount = totalTiles * cellCount;
+	const int threadCount = std::max<int>(1, std::min<int>(static_cast<int>(info.threadCount), itemCount));
+	parallelFor(threadCount, threadCount, [&]( int t ) {
+		const int first = static_cast<int>((static_cast<long long>(itemCount) * t) / threadCount);
+		const int last = static_cast<int>((static_cast<long long>(itemCount) * (t+1)) / threadCount);
+		emitRange(first, last);
+	});
+
+	return emittedCount > 0;
+}
\ No newline at end of file
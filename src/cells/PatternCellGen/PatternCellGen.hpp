@@ -0,0 +1,19 @@
+#ifndef __pattern_cell_generator__
+#define __pattern_cell_generator__
+
+#include <cells/ICellGen.hpp>
+
+/**
+ * Generates cells by fitting a precomputed CellPattern (CellGenInfo::patternPath) to the bounding box rather than computing
+ * any.  The pattern is scaled so that CellGenInfo::patternTiles copies of it span the bounding box along each axis, rotated
+ * about the center of the bounding box, and tiled as many times as needed to cover it.  Sample points are unused.
+ */
+class PatternCellGen : public ICellGen {
+public:
+	PatternCellGen();
+	~PatternCellGen();
+
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+};
+
+#endif /* __pattern_cell_generator__ */
\ No newline at end of file
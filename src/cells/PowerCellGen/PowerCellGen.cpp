@@ -0,0 +1,69 @@
+#include "PowerCellGen.hpp"
+#include <cells/VoroHelper.hpp>
+#include "../../MTLog.hpp"
+#include <ParallelFor.hpp>
+#include <atomic>
+
+PowerCellGen::PowerCellGen()
+	: ICellGen() {
+}
+
+PowerCellGen::~PowerCellGen() {
+}
+
+bool PowerCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	if( samplePoints.empty() ) {
+		return false;
+	}
+	if( info.sampleRadii.size() != samplePoints.size() ) {
+		MTLog::instance()->log("Error: Power cells need exactly one radius per sample point.\n");
+		return false;
+	}
+
+	// container bounds and morton order of the sample points
+	cc::Vec3f boundsMin;
+	cc::Vec3f boundsMax;
+	std::vector<int> order;
+	VoroHelper::prepareContainer(bbox, samplePoints, info.periodic, boundsMin, boundsMax, order);
+
+	// insert sample points into a pre-container so that voro++ can pick a grid size from the point count and bounds
+	voro::pre_container_poly preContainer(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y, boundsMin.z, boundsMax.z, info.periodic, info.periodic, info.periodic);
+	for( const int idx : order ) {
+		const cc::Vec3f& pos = samplePoints[idx];
+		preContainer.put(idx, static_cast<double>(pos.x), static_cast<double>(pos.y), static_cast<double>(pos.z), static_cast<double>(info.sampleRadii[idx]));
+	}
+	int resx = 0;
+	int resy = 0;
+	int resz = 0;
+	preContainer.guess_optimal(resx, resy, resz);
+
+	// trim cells to the optional walls
+	std::vector<std::unique_ptr<voro::wall_plane>> walls;
+	VoroHelper::makeInfoWalls(info, walls);
+
+	std::atomic<int> cellCount(0);
+	const CellVisitor countingVisitor = [&]( int id, const Cell& cell ) {
+		++cellCount;
+		visitor(id, cell);
+	};
+
+	// unlike voro::container, container_poly keeps the radius of the particle whose cell is being computed in the container
+	// itself, so threads cannot share one.  instead each thread fills its own copy (cheap next to computing the cells) and
+	// computes a contiguous range of its blocks.
+	const int blockCount = resx * resy * resz;
+	const int threadCount = std::max<int>(1, std::min<int>(static_cast<int>(info.threadCount), blockCount));
+	const auto computeRange = [&]( int firstBlock, int lastBlock ) {
+		const int initMem = 8;
+		voro::container_poly container(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y, boundsMin.z, boundsMax.z, resx, resy, resz, info.periodic, info.periodic, info.periodic, initMem);
+		preContainer.setup(container);
+		for( auto& wall : walls ) {
+			container.add_wall(*wall);
+		}
+		VoroHelper::computeBlockRange(container, samplePoints, &info.sampleRadii, firstBlock, lastBlock, info, countingVisitor);
+	};
+	parallelFor(threadCount, threadCount, [&]( int t ) {
+		computeRange((blockCount * t) / threadCount, (blockCount * (t+1)) / threadCount);
+	});
+
+	return cellCount > 0;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef __power_cell_generator__
+#define __power_cell_generator__
+
+#include <cells/ICellGen.hpp>
+
+/**
+ * Generates weighted (power diagram) cells, where each sample point's cell grows with its radius in CellGenInfo::sampleRadii.
+ */
+class PowerCellGen : public ICellGen {
+public:
+	PowerCellGen();
+	~PowerCellGen();
+
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+};
+
+#endif /* __power_cell_generator__ */
\ No newline at end of file
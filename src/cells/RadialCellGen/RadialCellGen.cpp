@@ -0,0 +1,142 @@
+#include "RadialCellGen.hpp"
+#include <cells/ConvexRegion.hpp>
+#include <ParallelFor.hpp>
+#include <Random.hpp>
+
+// seed of a crack (ring 0) or of a ring's crossing of a crack
+static unsigned int radialSeed( unsigned int seed, int crack, int ring ) {
+	unsigned int hash = (seed ^ 0x9e3779b9u) * 0x85ebca6bu;
+	hash = (hash ^ static_cast<unsigned int>(crack)) * 0xc2b2ae35u;
+	hash = (hash ^ static_cast<unsigned int>(ring)) * 0x27d4eb2fu;
+	return hash ^ (hash >> 15);
+}
+
+RadialCellGen::RadialCellGen()
+	: ICellGen() {
+}
+
+RadialCellGen::~RadialCellGen() {
+}
+
+bool RadialCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	// cells start as a box slightly larger than the bounding box, so that the outermost cells need no planes on the outside
+	const float EXP = 0.1f;
+	const cc::Vec3f boxMin(bbox.minX()-EXP, bbox.minY()-EXP, bbox.minZ()-EXP);
+	const cc::Vec3f boxMax(bbox.maxX()+EXP, bbox.maxY()+EXP, bbox.maxZ()+EXP);
+	const cc::Vec3f size = bbox.getHalfExtents() * 2.0f;
+
+	// the pane faces along its thinnest axis, and cracks run across the other two
+	int normalAxis = 0;
+	if( size.y < (&size.x)[normalAxis] ) {
+		normalAxis = 1;
+	}
+	if( size.z < (&size.x)[normalAxis] ) {
+		normalAxis = 2;
+	}
+	cc::Vec3f axisU(0.0f, 0.0f, 0.0f);
+	cc::Vec3f axisV(0.0f, 0.0f, 0.0f);
+	(&axisU.x)[(normalAxis + 1) % 3] = 1.0f;
+	(&axisV.x)[(normalAxis + 2) % 3] = 1.0f;
+	const cc::Vec3f axisN = axisU.cross(axisV);
+	const cc::Vec3f impact = info.hasImpactPoint ? info.impactPoint : bbox.getCenter();
+
+	// rings must reach the furthest corner of the box across the pane
+	const float reachU = std::max<float>(fabsf((boxMin - impact).dot(axisU)), fabsf((boxMax - impact).dot(axisU)));
+	const float reachV = std::max<float>(fabsf((boxMin - impact).dot(axisV)), fabsf((boxMax - impact).dot(axisV)));
+	const float maxRadius = sqrtf(reachU * reachU + reachV * reachV);
+	if( maxRadius <= 0.0f ) {
+		return false;
+	}
+
+	const int wedgeCount = std::max<int>(3, static_cast<int>(info.radialWedges));
+	const int ringCount = std::max<int>(1, static_cast<int>(info.radialRings));
+	const float growth = static_cast<float>(cc::math::clamp<double>(info.radialGrowth, 1.0, 10.0));
+	const float jitter = static_cast<float>(cc::math::clamp<double>(info.radialJitter * 0.01, 0.0, 1.0));
+
+	// ring widths grow geometrically so that the rings together span maxRadius
+	std::vector<float> ringRadii(ringCount + 1, 0.0f);
+	std::vector<float> ringWidths(ringCount, 0.0f);
+	const float firstWidth = (growth > 1.0f) ? maxRadius * (growth - 1.0f) / (powf(growth, static_cast<float>(ringCount)) - 1.0f) : maxRadius / static_cast<float>(ringCount);
+	for( int ring = 0; ring < ringCount; ++ring ) {
+		ringWidths[ring] = firstWidth * powf(growth, static_cast<float>(ring));
+		ringRadii[ring+1] = ringRadii[ring] + ringWidths[ring];
+	}
+
+	// cracks are evenly spaced around a random turn, each turning by up to a fifth of the spacing so that no wedge reaches half a turn
+	const float TWO_PI = 6.28318531f;
+	const float angleStep = TWO_PI / static_cast<float>(wedgeCount);
+	const float startAngle = Random<float, int>(radialSeed(info.seed, -1, 0)).nextReal(0.0f, angleStep);
+	std::vector<cc::Vec3f> crackDirections(wedgeCount);
+	for( int crack = 0; crack < wedgeCount; ++crack ) {
+		Random<float, int> rnd(radialSeed(info.seed, crack, 0));
+		const float angle = startAngle + angleStep * (static_cast<float>(crack) + rnd.nextReal(-0.2f, 0.2f) * jitter);
+		crackDirections[crack] = axisU * cosf(angle) + axisV * sinf(angle);
+	}
+
+	// rings cross each crack at their radius moved by up to a third of the narrower neighboring width, so that they stay in order
+	const auto ringPoint = [&]( int crack, int ring ) {
+		crack = crack % wedgeCount;
+		Random<float, int> rnd(radialSeed(info.seed, crack, ring));
+		const float reach = 0.3f * jitter * ringWidths[ring-1];
+		return impact + crackDirections[crack] * (ringRadii[ring] + rnd.nextReal(-reach, reach));
+	};
+
+	// a ring between two cracks is the straight line between its crossings of them, facing away from the impact point
+	const auto ringPlane = [&]( int wedge, int ring ) {
+		const cc::Vec3f start = ringPoint(wedge, ring);
+		const cc::Vec3f end = ringPoint(wedge + 1, ring);
+		cc::Vec3f normal = axisN.cross(end - start);
+		if( normal.dot(start - impact) < 0.0f ) {
+			normal = -normal;
+		}
+		Plane plane = Plane::constructFromPointNormal(start, normal);
+		plane.pointOnPlane = start;
+		return plane;
+	};
+
+	// a crack faces toward the wedge after it
+	const auto crackPlane = [&]( int crack ) {
+		const cc::Vec3f& direction = crackDirections[crack % wedgeCount];
+		Plane plane = Plane::constructFromPointNormal(impact, axisN.cross(direction));
+		plane.pointOnPlane = impact;
+		return plane;
+	};
+
+	std::atomic<int> cellCount(0);
+	parallelFor(info.threadCount, wedgeCount, [&]( int wedge ) {
+		Cell scratch;
+		std::vector<Plane> planes;
+		for( int ring = 0; ring < ringCount; ++ring ) {
+			// neighbors are the same ring of the wedges either side, and the rings inside and outside of the same wedge
+			planes.clear();
+			planes.push_back(crackPlane(wedge));
+			planes.back().neighborId = ((wedge + wedgeCount - 1) % wedgeCount) * ringCount + ring;
+			planes.push_back(crackPlane(wedge + 1).flipped());
+			planes.back().neighborId = ((wedge + 1) % wedgeCount) * ringCount + ring;
+			if( ring > 0 ) {
+				planes.push_back(ringPlane(wedge, ring));
+				planes.back().neighborId = wedge * ringCount + ring - 1;
+			}
+			if( ring + 1 < ringCount ) {
+				planes.push_back(ringPlane(wedge, ring + 1).flipped());
+				planes.back().neighborId = wedge * ringCount + ring + 1;
+			}
+
+			ConvexRegion region = ConvexRegion::box(boxMin, boxMax);
+			bool isEmpty = false;
+			for( const auto& plane : planes ) {
+				if( !region.clip(plane) ) {
+					isEmpty = true;
+					break;
+				}
+			}
+			if( isEmpty ) {
+				continue;
+			}
+			region.toCell(info, scratch);
+			++cellCount;
+			visitor(wedge * ringCount + ring, scratch);
+		}
+	});
+	return cellCount > 0;
+}
\ No newline at end of file
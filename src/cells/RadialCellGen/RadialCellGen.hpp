@@ -0,0 +1,21 @@
+#ifndef __radial_cell_generator__
+#define __radial_cell_generator__
+
+#include <cells/ICellGen.hpp>
+
+/**
+ * Generates shattered glass cells around an impact point in closed form rather than computing a voronoi diagram.  Cracks
+ * run out from the impact point as CellGenInfo::radialWedges wedges, which are crossed by CellGenInfo::radialRings rings
+ * whose spacing grows by CellGenInfo::radialGrowth outward.  The pane is taken to face along the bounding box's thinnest
+ * axis, and cells are prisms through it.  CellGenInfo::radialJitter turns the cracks and moves the rings along each crack
+ * at random.  The impact point is CellGenInfo::impactPoint if given, or else the bounding box's center.  Sample points are unused.
+ */
+class RadialCellGen : public ICellGen {
+public:
+	RadialCellGen();
+	~RadialCellGen();
+
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+};
+
+#endif /* __radial_cell_generator__ */
\ No newline at end of file
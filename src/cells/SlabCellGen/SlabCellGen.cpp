@@ -0,0 +1,144 @@
+#include "SlabCellGen.hpp"
+#include <cells/ConvexRegion.hpp>
+#include <Random.hpp>
+#include <ParallelFor.hpp>
+#include <atomic>
+
+// number of random directions to try before giving up on splitting points that coincide along all of them
+static const int MAX_SPLIT_ATTEMPTS = 8;
+
+// minimum distance between the two middle points along a direction for the points to be split between them
+static const float MIN_MEDIAN_GAP = 0.00001f;
+
+// a region of space along with the sample points inside of it
+struct SlabRegion {
+	ConvexRegion region;
+	std::vector<int> points;
+};
+
+// splits a region's points in half at their median along a random direction, and the region along with them.  returns false
+// if the points could not be told apart or the plane between them missed the region.
+static bool splitRegionAtMedian( const SlabRegion& region, const std::vector<cc::Vec3f>& samplePoints, SlabRegion& outPositive, SlabRegion& outNegative ) {
+	Plane plane;
+	if( !SlabCellGen::splitPointsAtMedian(samplePoints, region.points, plane, outPositive.points, outNegative.points) ) {
+		return false;
+	}
+	return region.region.split(plane, outPositive.region, outNegative.region);
+}
+
+SlabCellGen::SlabCellGen()
+	: ICellGen() {
+}
+
+SlabCellGen::~SlabCellGen() {
+}
+
+bool SlabCellGen::splitPointsAtMedian( const std::vector<cc::Vec3f>& samplePoints, const std::vector<int>& points, Plane& outPlane, std::vector<int>& outPositive, std::vector<int>& outNegative ) {
+	if( points.size() < 2 ) {
+		return false;
+	}
+
+	// seeded by the points rather than shared, so that the result does not depend on the order regions are split in
+	Random<float, int> rnd(static_cast<unsigned int>(points.front()) * 0x9e3779b9u + static_cast<unsigned int>(points.size()));
+	std::vector<std::pair<float, int>> projected(points.size());
+	for( int attempt = 0; attempt < MAX_SPLIT_ATTEMPTS; ++attempt ) {
+		// uniformly random direction
+		const float z = rnd.nextReal(-1.0f, 1.0f);
+		const float theta = rnd.nextReal(0.0f, 6.28318531f);
+		const float r = sqrtf(std::max<float>(0.0f, 1.0f - z*z));
+		const cc::Vec3f normal(r * cosf(theta), r * sinf(theta), z);
+
+		for( size_t i = 0; i < points.size(); ++i ) {
+			projected[i] = std::make_pair(normal.dot(samplePoints[points[i]]), points[i]);
+		}
+		std::sort(projected.begin(), projected.end());
+		const size_t half = projected.size() / 2;
+		if( projected[half].first - projected[half-1].first <= MIN_MEDIAN_GAP ) {
+			continue;
+		}
+
+		// the plane lies halfway between the two middle points, facing the upper half
+		const float offset = 0.5f * (projected[half-1].first + projected[half].first);
+		outPlane = Plane(normal, -offset);
+		outPlane.pointOnPlane = normal * offset;
+		outPositive.clear();
+		outNegative.clear();
+		for( size_t i = 0; i < projected.size(); ++i ) {
+			((i < half) ? outNegative : outPositive).push_back(projected[i].second);
+		}
+		return true;
+	}
+	return false;
+}
+
+bool SlabCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	const bool useCutPlanes = !info.cutPlanes.empty();
+	if( !useCutPlanes && samplePoints.empty() ) {
+		return false;
+	}
+
+	// the root region is a box slightly larger than the bounding box, so that no cell's outer faces graze the mesh.  its own
+	// faces are never used as planes, as the mesh is entirely inside of it.
+	const float EXP = 0.1f;
+	std::vector<SlabRegion> regions;
+	regions.push_back(SlabRegion());
+	regions.front().region = ConvexRegion::box(cc::Vec3f(bbox.minX()-EXP, bbox.minY()-EXP, bbox.minZ()-EXP), cc::Vec3f(bbox.maxX()+EXP, bbox.maxY()+EXP, bbox.maxZ()+EXP));
+	if( !useCutPlanes ) {
+		for( size_t i = 0; i < samplePoints.size(); ++i ) {
+			regions.front().points.push_back(static_cast<int>(i));
+		}
+	}
+
+	std::atomic<int> cellCount(0);
+	const auto emit = [&]( int id, const SlabRegion& region, Cell& scratch ) {
+		region.region.toCell(info, scratch);
+		++cellCount;
+		visitor(id, scratch);
+	};
+
+	// each level splits every region of the previous one.  regions done splitting are emitted straight away (by point)
+	// when splitting at medians; otherwise all regions are emitted after the last plane, numbered in order.
+	const unsigned int levelCount = useCutPlanes ? static_cast<unsigned int>(info.cutPlanes.size()) : std::numeric_limits<unsigned int>::max();
+	for( unsigned int level = 0; level < levelCount && !regions.empty(); ++level ) {
+		std::vector<std::vector<SlabRegion>> children(regions.size());
+		parallelFor(info.threadCount, static_cast<int>(regions.size()), [&]( int i ) {
+			const SlabRegion& region = regions[i];
+			std::vector<SlabRegion>& outChildren = children[i];
+			outChildren.resize(2);
+			bool wasSplit = false;
+			if( useCutPlanes ) {
+				wasSplit = region.region.split(info.cutPlanes[level], outChildren[0].region, outChildren[1].region);
+			} else if( region.points.size() > 1 ) {
+				wasSplit = splitRegionAtMedian(region, samplePoints, outChildren[0], outChildren[1]);
+			}
+			if( wasSplit ) {
+				return;
+			}
+			outChildren.clear();
+			if( useCutPlanes ) {
+				outChildren.push_back(region);
+			} else {
+				Cell scratch;
+				emit(region.points.front(), region, scratch);
+			}
+		});
+
+		std::vector<SlabRegion> nextRegions;
+		for( auto& list : children ) {
+			for( auto& child : list ) {
+				nextRegions.push_back(std::move(child));
+			}
+		}
+		regions.swap(nextRegions);
+	}
+
+	// regions cut out by the given planes
+	if( useCutPlanes ) {
+		parallelFor(info.threadCount, static_cast<int>(regions.size()), [&]( int i ) {
+			Cell scratch;
+			emit(i, regions[i], scratch);
+		});
+	}
+
+	return cellCount > 0;
+}
\ No newline at end of file
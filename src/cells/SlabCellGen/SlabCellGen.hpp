@@ -0,0 +1,32 @@
+#ifndef __slab_cell_generator__
+#define __slab_cell_generator__
+
+#include <cells/ICellGen.hpp>
+
+/**
+ * Generates cells by recursively splitting space with planes (a binary space partition) rather than computing a voronoi diagram.
+ * If CellGenInfo::cutPlanes is empty, each region is split in two through the median of its sample points along a random
+ * direction until each region holds a single sample point, whose cell it becomes.  Otherwise, each of the given planes in turn
+ * splits every region that it crosses, and sample points are unused.  Cells only have the planes that split them, so they are
+ * very cheap to slice.  Regions of a level are split in parallel, each cut once with both halves passed down to the next level.
+ */
+class SlabCellGen : public ICellGen {
+public:
+	SlabCellGen();
+	~SlabCellGen();
+
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+
+	/**
+	 * Splits sample points in half through their median along a random direction, seeded by the points.
+	 * @param[in]  samplePoints All sample points.
+	 * @param[in]  points       Indices of the sample points to split.
+	 * @param[out] outPlane     Plane between the halves, facing the positive half.
+	 * @param[out] outPositive  Indices of the points on the positive side of the plane.
+	 * @param[out] outNegative  Indices of the points on the negative side of the plane.
+	 * @returns False if there are fewer than two points or they could not be told apart along any direction tried; true otherwise.
+	 */
+	static bool splitPointsAtMedian( const std::vector<cc::Vec3f>& samplePoints, const std::vector<int>& points, Plane& outPlane, std::vector<int>& outPositive, std::vector<int>& outNegative );
+};
+
+#endif /* __slab_cell_generator__ */
\ No newline at end of file
@@ -0,0 +1,258 @@
+#ifndef __voro_helper__
+#define __voro_helper__
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <cstdint>
+#include <voro++.hh>
+#include <cc/Vec3.hpp>
+#include <Plane.hpp>
+#include <BoundingBox.hpp>
+#include "Cell.hpp"
+#include "CellGenInfo.hpp"
+#include "ICellGen.hpp"
+
+namespace VoroHelper {
+	// voro++ numbers the container's own walls -1 to -6, so CellGenInfo's walls are numbered downwards from here
+	static const int FIRST_INFO_WALL_ID = -7;
+
+	// buffers reused by a thread for every cell it computes
+	struct CellScratch {
+		voro::voronoicell_neighbor cell;
+		std::vector<int> faceVertices;
+		std::vector<int> neighbors;
+		Cell outCell;
+	};
+
+	// spreads the lower 10 bits of v so that there are two zero bits between each
+	static uint32_t expandMortonBits( uint32_t v ) {
+		v &= 0x3ff;
+		v = (v | (v << 16)) & 0x030000ff;
+		v = (v | (v <<  8)) & 0x0300f00f;
+		v = (v | (v <<  4)) & 0x030c30c3;
+		v = (v | (v <<  2)) & 0x09249249;
+		return v;
+	}
+
+	// 30-bit morton code of a point quantized to a 1024^3 grid over the given bounds
+	static uint32_t mortonCode( const cc::Vec3f& point, const cc::Vec3f& min, const cc::Vec3f& size ) {
+		const float qx = cc::math::clamp<float>((point.x - min.x) / size.x, 0.0f, 1.0f) * 1023.0f;
+		const float qy = cc::math::clamp<float>((point.y - min.y) / size.y, 0.0f, 1.0f) * 1023.0f;
+		const float qz = cc::math::clamp<float>((point.z - min.z) / size.z, 0.0f, 1.0f) * 1023.0f;
+		return (expandMortonBits(static_cast<uint32_t>(qx)) << 2) | (expandMortonBits(static_cast<uint32_t>(qy)) << 1) | expandMortonBits(static_cast<uint32_t>(qz));
+	}
+
+	// computes the bounds of a container around the bounding box, and the order (along a morton curve) to insert sample
+	// points in so that particles close in space are inserted (and stored) close in memory.  periodic containers span
+	// the bounding box exactly so that their cells tile it.
+	static void prepareContainer( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, bool periodic, cc::Vec3f& outMin, cc::Vec3f& outMax, std::vector<int>& outOrder ) {
+		const float EXP = periodic ? 0.0f : 0.1f;
+		outMin = cc::Vec3f(bbox.minX()-EXP, bbox.minY()-EXP, bbox.minZ()-EXP);
+		outMax = cc::Vec3f(bbox.maxX()+EXP, bbox.maxY()+EXP, bbox.maxZ()+EXP);
+		const cc::Vec3f size = outMax - outMin;
+
+		std::vector<std::pair<uint32_t, int>> codes(samplePoints.size());
+		for( size_t i = 0; i < samplePoints.size(); ++i ) {
+			codes[i] = std::make_pair(mortonCode(samplePoints[i], outMin, size), static_cast<int>(i));
+		}
+		std::sort(codes.begin(), codes.end());
+
+		outOrder.resize(codes.size());
+		for( size_t i = 0; i < codes.size(); ++i ) {
+			outOrder[i] = codes[i].second;
+		}
+	}
+
+	// builds voro++ walls for the optional CellGenInfo walls.  a voro++ plane wall keeps the side where dot(n, p) < a, so ours are flipped.
+	// periodic containers have no boundary to trim, so they get no walls.
+	static void makeInfoWalls( const CellGenInfo& info, std::vector<std::unique_ptr<voro::wall_plane>>& outWalls ) {
+		outWalls.clear();
+		if( info.periodic ) {
+			return;
+		}
+		for( size_t i = 0; i < info.walls.size(); ++i ) {
+			const Plane& plane = info.walls[i];
+			outWalls.push_back(std::unique_ptr<voro::wall_plane>(new voro::wall_plane(-plane.normal.x, -plane.normal.y, -plane.normal.z, plane.constant, FIRST_INFO_WALL_ID - static_cast<int>(i))));
+		}
+	}
+
+	// builds the plane of one of the container's walls (voro++ numbers them -1 to -6 for -x, +x, -y, +y, -z, +z),
+	// facing into the container
+	static bool containerWallPlane( const voro::container_base& container, int wallId, Plane& outPlane ) {
+		switch( wallId ) {
+			case -1: {
+				outPlane = Plane(cc::Vec3f(1.0f, 0.0f, 0.0f), static_cast<float>(-container.ax));
+				break;
+			}
+			case -2: {
+				outPlane = Plane(cc::Vec3f(-1.0f, 0.0f, 0.0f), static_cast<float>(container.bx));
+				break;
+			}
+			case -3: {
+				outPlane = Plane(cc::Vec3f(0.0f, 1.0f, 0.0f), static_cast<float>(-container.ay));
+				break;
+			}
+			case -4: {
+				outPlane = Plane(cc::Vec3f(0.0f, -1.0f, 0.0f), static_cast<float>(container.by));
+				break;
+			}
+			case -5: {
+				outPlane = Plane(cc::Vec3f(0.0f, 0.0f, 1.0f), static_cast<float>(-container.az));
+				break;
+			}
+			case -6: {
+				outPlane = Plane(cc::Vec3f(0.0f, 0.0f, -1.0f), static_cast<float>(container.bz));
+				break;
+			}
+			default: {
+				return false;
+			}
+		}
+		outPlane.neighborId = wallId;
+		return true;
+	}
+
+	// builds the plane between seed and neighbor, facing seed.  without radii this is the perpendicular bisector; with
+	// radii it is the radical plane of the power diagram, where |x-seed|^2 - seedRadius^2 = |x-neighbor|^2 - neighborRadius^2
+	static bool seedPairPlane( const cc::Vec3f& seed, float seedRadius, const cc::Vec3f& neighbor, float neighborRadius, Plane& outPlane ) {
+		const cc::Vec3f toNeighbor = neighbor - seed;
+		const float sqrDistance = toNeighbor.sqrMagnitude();
+		if( sqrDistance <= 0.0f ) {
+			return false;
+		}
+		const float t = 0.5f + (seedRadius*seedRadius - neighborRadius*neighborRadius) / (2.0f * sqrDistance);
+		const cc::Vec3f pointOnPlane = seed + toNeighbor * t;
+		outPlane = Plane::constructFromPointNormal(pointOnPlane, toNeighbor * -1.0f);
+		outPlane.pointOnPlane = pointOnPlane;
+		return true;
+	}
+
+	// finds which periodic image of neighbor (offset by -1, 0 or +1 periods along each axis) shares the face containing
+	// pointOnFace with seed.  every point on that face has equal power distance, |x-p|^2 - r^2, to the seed and to the image.
+	static cc::Vec3f periodicImage( const cc::Vec3f& period, const cc::Vec3f& seed, float seedRadius, const cc::Vec3f& neighbor, float neighborRadius, const cc::Vec3f& pointOnFace, int outOffset[3] ) {
+		const float seedPower = (pointOnFace - seed).sqrMagnitude() - seedRadius*seedRadius;
+		float bestError = std::numeric_limits<float>::max();
+		cc::Vec3f bestImage = neighbor;
+		for( int z = -1; z <= 1; ++z ) {
+			for( int y = -1; y <= 1; ++y ) {
+				for( int x = -1; x <= 1; ++x ) {
+					const cc::Vec3f image(neighbor.x + period.x * x, neighbor.y + period.y * y, neighbor.z + period.z * z);
+					const float error = fabsf((pointOnFace - image).sqrMagnitude() - neighborRadius*neighborRadius - seedPower);
+					if( error < bestError ) {
+						bestError = error;
+						bestImage = image;
+						outOffset[0] = x;
+						outOffset[1] = y;
+						outOffset[2] = z;
+					}
+				}
+			}
+		}
+		return bestImage;
+	}
+
+	// converts the computed voro++ cell of the particle with the given id at (off_x, off_y, off_z) into scratch.outCell,
+	// only filling in the parts of the cell that info asks for.  each face of a cell lies on the plane between the cell's
+	// seed and the neighboring seed across it, so planes are built from the seed pair rather than fit to the face's
+	// (possibly near-degenerate) vertices.  radii is null for unweighted cells.
+	static void convertCell( const voro::container_base& container, const std::vector<cc::Vec3f>& samplePoints, const std::vector<float>* radii, int id, double off_x, double off_y, double off_z, const CellGenInfo& info, CellScratch& scratch ) {
+		Cell& outCell = scratch.outCell;
+		outCell.clear();
+
+		// neighbor ids are in the same order as the faces
+		std::vector<int>& neighbors = scratch.neighbors;
+		scratch.cell.neighbors(neighbors);
+
+		// faces are needed for output, or in periodic containers to tell which image of a neighbor is across each face
+		std::vector<int>& faceVertices = scratch.faceVertices;
+		const bool hasFaceVertices = info.needsFaces || info.periodic;
+		if( hasFaceVertices ) {
+			scratch.cell.face_vertices(faceVertices);
+		}
+
+		if( info.needsPlanes ) {
+			const cc::Vec3f seed(static_cast<float>(off_x), static_cast<float>(off_y), static_cast<float>(off_z));
+			const float seedRadius = (radii != nullptr) ? (*radii)[id] : 0.0f;
+			const cc::Vec3f period(static_cast<float>(container.bx - container.ax), static_cast<float>(container.by - container.ay), static_cast<float>(container.bz - container.az));
+			size_t faceStart = 0;
+			for( const int neighborId : neighbors ) {
+				Plane plane;
+				if( neighborId >= 0 ) {
+					const float neighborRadius = (radii != nullptr) ? (*radii)[neighborId] : 0.0f;
+					cc::Vec3f neighbor = samplePoints[neighborId];
+					if( info.periodic ) {
+						const int vertsInFace = faceVertices[faceStart];
+						cc::Vec3f faceCenter;
+						for( int j = 0; j < vertsInFace; ++j ) {
+							const int vtx = faceVertices[faceStart+1+j];
+							faceCenter += cc::Vec3f(static_cast<float>(0.5 * scratch.cell.pts[3*vtx]), static_cast<float>(0.5 * scratch.cell.pts[3*vtx+1]), static_cast<float>(0.5 * scratch.cell.pts[3*vtx+2]));
+						}
+						faceCenter = seed + faceCenter / static_cast<float>(vertsInFace);
+						int offset[3];
+						neighbor = periodicImage(period, seed, seedRadius, neighbor, neighborRadius, faceCenter, offset);
+					}
+					if( seedPairPlane(seed, seedRadius, neighbor, neighborRadius, plane) ) {
+						plane.neighborId = neighborId;
+						outCell.addPlane(plane);
+					}
+				} else if( containerWallPlane(container, neighborId, plane) ) {
+					outCell.addPlane(plane);
+				} else {
+					const int wallIndex = FIRST_INFO_WALL_ID - neighborId;
+					if( wallIndex >= 0 && wallIndex < static_cast<int>(info.walls.size()) ) {
+						plane = info.walls[wallIndex];
+						plane.neighborId = neighborId;
+						outCell.addPlane(plane);
+					}
+				}
+				if( hasFaceVertices ) {
+					faceStart += faceVertices[faceStart] + 1;
+				}
+			}
+		}
+
+		if( !info.needsFaces ) {
+			return;
+		}
+
+		 // get all cell points in a usable format
+		for( int i = 0; i < scratch.cell.p; ++i ) {
+			const float x = static_cast<float>(off_x + (0.5 * scratch.cell.pts[3*i]));
+			const float y = static_cast<float>(off_y + (0.5 * scratch.cell.pts[3*i+1]));
+			const float z = static_cast<float>(off_z + (0.5 * scratch.cell.pts[3*i+2]));
+			outCell.addVertex(cc::Vec3f(x, y, z));
+		}
+
+		// extract faces
+		for( size_t i = 0;  i < faceVertices.size(); ) {
+			const int vertsInFace = faceVertices[i]; // k, k+k1, k+k1+k2, ...
+			outCell.addFace(&faceVertices[i+1], vertsInFace);
+			i += vertsInFace+1;
+		}
+	}
+
+	// computes the cells of all particles within blocks [firstBlock, lastBlock) of the container and hands them to the
+	// visitor.  uses its own voro_compute, which holds the search state that container::compute_cell would otherwise share.
+	template<class Container>
+	static void computeBlockRange( Container& container, const std::vector<cc::Vec3f>& samplePoints, const std::vector<float>* radii, int firstBlock, int lastBlock, const CellGenInfo& info, const ICellGen::CellVisitor& visitor ) {
+		voro::voro_compute<Container> compute(container, container.nx, container.ny, container.nz);
+		CellScratch scratch;
+		for( int ijk = firstBlock; ijk < lastBlock; ++ijk ) {
+			const int k = ijk / container.nxy;
+			const int j = (ijk - container.nxy * k) / container.nx;
+			const int i = ijk - container.nxy * k - container.nx * j;
+			for( int q = 0; q < container.co[ijk]; ++q ) {
+				if( !compute.compute_cell(scratch.cell, ijk, q, i, j, k) ) {
+					continue;
+				}
+				const int id = container.id[ijk][q];
+				const double* pp = container.p[ijk] + container.ps * q;
+				convertCell(container, samplePoints, radii, id, pp[0], pp[1], pp[2], info, scratch);
+				visitor(id, scratch.outCell);
+			}
+		}
+	}
+} // VoroHelper
+
+#endif /* __voro_helper__ */
\ No newline at end of file
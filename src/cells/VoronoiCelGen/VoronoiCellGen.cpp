@@ -1,6 +1,7 @@
 #include "VoronoiCellGen.hpp"
-#include <voro++.hh>
-#include <PlaneHelper.hpp>
+#include <cells/VoroHelper.hpp>
+#include <ParallelFor.hpp>
+#include <atomic>
 
 VoronoiCellGen::VoronoiCellGen()
 	: ICellGen() {
@@ -9,87 +10,184 @@ VoronoiCellGen::VoronoiCellGen()
 VoronoiCellGen::~VoronoiCellGen() {
 }
 
-bool VoronoiCellGen::generate( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, std::vector<Cell>& outCells ) const {
+bool VoronoiCellGen::generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
 	if( samplePoints.empty() ) {
 		return false;
 	}
 
-	// clear existing data
-	outCells.clear();
+	// periodic cells wrap around the whole container, so they cannot be split into tiles
+	if( !info.periodic && info.tileSeedCount > 0 && samplePoints.size() > info.tileSeedCount ) {
+		return generateTiled(bbox, samplePoints, info, visitor);
+	}
+
+	// container bounds and morton order of the sample points
+	cc::Vec3f boundsMin;
+	cc::Vec3f boundsMax;
+	std::vector<int> order;
+	VoroHelper::prepareContainer(bbox, samplePoints, info.periodic, boundsMin, boundsMax, order);
+
+	// insert sample points into a pre-container so that voro++ can pick a grid size from the point count and bounds
+	voro::pre_container preContainer(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y, boundsMin.z, boundsMax.z, info.periodic, info.periodic, info.periodic);
+	for( const int idx : order ) {
+		const cc::Vec3f& pos = samplePoints[idx];
+		preContainer.put(idx, static_cast<double>(pos.x), static_cast<double>(pos.y), static_cast<double>(pos.z));
+	}
+	int resx = 0;
+	int resy = 0;
+	int resz = 0;
+	preContainer.guess_optimal(resx, resy, resz);
 
-	// create container
+	// create container and copy the points over in morton order
 	const int initMem = 8;
-	const int resx = 6;
-	const int resy = 6;
-	const int resz = 6;
-	const float EXP = 0.1f;
-	voro::container container(bbox.minX()-EXP, bbox.maxX()+EXP, bbox.minY()-EXP, bbox.maxY()+EXP, bbox.minZ()-EXP, bbox.maxZ()+EXP, resx, resy, resz, false, false, false, initMem);
-
-	// insert sample points
-	for( size_t i = 0; i < samplePoints.size(); ++i ) {
-		const cc::Vec3f& pos = samplePoints[i];
-		container.put(i, static_cast<double>(pos.x), static_cast<double>(pos.y), static_cast<double>(pos.z));
+	voro::container container(boundsMin.x, boundsMax.x, boundsMin.y, boundsMax.y, boundsMin.z, boundsMax.z, resx, resy, resz, info.periodic, info.periodic, info.periodic, initMem);
+	preContainer.setup(container);
+
+	// trim cells to the optional walls
+	std::vector<std::unique_ptr<voro::wall_plane>> walls;
+	VoroHelper::makeInfoWalls(info, walls);
+	for( auto& wall : walls ) {
+		container.add_wall(*wall);
+	}
+
+	// split the container's blocks into contiguous ranges, one per thread
+	const int blockCount = container.nxyz;
+	const int threadCount = std::max<int>(1, std::min<int>(static_cast<int>(info.threadCount), blockCount));
+	std::atomic<int> cellCount(0);
+	const CellVisitor countingVisitor = [&]( int id, const Cell& cell ) {
+		++cellCount;
+		visitor(id, cell);
+	};
+	parallelFor(threadCount, threadCount, [&]( int t ) {
+		const int firstBlock = (blockCount * t) / threadCount;
+		const int lastBlock = (blockCount * (t+1)) / threadCount;
+		VoroHelper::computeBlockRange(container, samplePoints, nullptr, firstBlock, lastBlock, info, countingVisitor);
+	});
+
+	//container.draw_cells_gnuplot("C:/Users/daniel/Desktop/cells.gnu");
+	//container.draw_particles("C:/Users/daniel/Desktop/particles.gnu");
+
+	return cellCount > 0;
+}
+
+bool VoronoiCellGen::generateTiled( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const {
+	// bounds of the whole container that tiles are cut from
+	cc::Vec3f boundsMin;
+	cc::Vec3f boundsMax;
+	std::vector<int> order;
+	VoroHelper::prepareContainer(bbox, samplePoints, false, boundsMin, boundsMax, order);
+	const cc::Vec3f boundsSize = boundsMax - boundsMin;
+
+	// split into equal tiles along each axis so that each holds around tileSeedCount points
+	const double tilesNeeded = static_cast<double>(samplePoints.size()) / static_cast<double>(info.tileSeedCount);
+	const int tilesPerAxis = std::max<int>(1, static_cast<int>(ceil(cbrt(tilesNeeded))));
+	const int tileCount = tilesPerAxis * tilesPerAxis * tilesPerAxis;
+	const cc::Vec3f tileSize = boundsSize * (1.0f / static_cast<float>(tilesPerAxis));
+	const auto tileCoord = [&]( float value, float min, float size ) {
+		return cc::math::clamp<int>(static_cast<int>((value - min) / size), 0, tilesPerAxis-1);
+	};
+
+	// bin points (in morton order, so that each tile's points are close in memory) into the tile that they lie in
+	std::vector<std::vector<int>> tilePoints(tileCount);
+	for( const int idx : order ) {
+		const cc::Vec3f& pos = samplePoints[idx];
+		const int tx = tileCoord(pos.x, boundsMin.x, tileSize.x);
+		const int ty = tileCoord(pos.y, boundsMin.y, tileSize.y);
+		const int tz = tileCoord(pos.z, boundsMin.z, tileSize.z);
+		tilePoints[tx + tilesPerAxis * (ty + tilesPerAxis * tz)].push_back(idx);
 	}
 
-	voro::c_loop_all cla(container);
-	voro::voronoicell cell;
-	if( cla.start() ) {
-		do {
-			if( container.compute_cell(cell, cla) ) {
-				Cell newCell;
-
-				// compute offset for current cell
-				const double* pp = container.p[cla.ijk] + container.ps * cla.q;
-				const double off_x = *pp;
-				const double off_y = pp[1];
-				const double off_z = pp[2];
-
-				 // get all cell points in a usable format
-				std::vector<cc::Vec3f> cellPoints;
-				for( int i = 0; i < cell.p; ++i ) {
-					const float x = static_cast<float>(off_x + (0.5 * cell.pts[3*i]));
-					const float y = static_cast<float>(off_y + (0.5 * cell.pts[3*i+1]));
-					const float z = static_cast<float>(off_z + (0.5 * cell.pts[3*i+2]));
-					cellPoints.push_back(cc::Vec3f(x, y, z));
+	// a cell is only exact if no point beyond the halo can cut it, which holds when the halo is at least twice as thick as
+	// the cell's furthest vertex is from its seed.  start at a few times the mean spacing of points, which covers nearly all cells.
+	const float meanSpacing = static_cast<float>(cbrt((boundsSize.x * boundsSize.y * boundsSize.z) / static_cast<double>(samplePoints.size())));
+	const float initialHalo = 3.0f * meanSpacing;
+
+	std::vector<std::unique_ptr<voro::wall_plane>> walls;
+	VoroHelper::makeInfoWalls(info, walls);
+
+	std::atomic<int> cellCount(0);
+	const auto computeTile = [&]( int tile ) {
+		const int tx = tile % tilesPerAxis;
+		const int ty = (tile / tilesPerAxis) % tilesPerAxis;
+		const int tz = tile / (tilesPerAxis * tilesPerAxis);
+		const cc::Vec3f coreMin(boundsMin.x + tileSize.x * tx, boundsMin.y + tileSize.y * ty, boundsMin.z + tileSize.z * tz);
+		const cc::Vec3f coreMax = coreMin + tileSize;
+
+		// points whose cells are still to be emitted, sorted for lookup
+		std::vector<int> pending = tilePoints[tile];
+		std::sort(pending.begin(), pending.end());
+		VoroHelper::CellScratch scratch;
+		for( float halo = initialHalo; !pending.empty(); halo *= 2.0f ) {
+			// the halo is clamped to the whole container, where the tile's walls are the real walls
+			const cc::Vec3f haloMin(std::max<float>(coreMin.x - halo, boundsMin.x), std::max<float>(coreMin.y - halo, boundsMin.y), std::max<float>(coreMin.z - halo, boundsMin.z));
+			const cc::Vec3f haloMax(std::min<float>(coreMax.x + halo, boundsMax.x), std::min<float>(coreMax.y + halo, boundsMax.y), std::min<float>(coreMax.z + halo, boundsMax.z));
+			const bool isWhole = haloMin.x <= boundsMin.x && haloMin.y <= boundsMin.y && haloMin.z <= boundsMin.z &&
+			                     haloMax.x >= boundsMax.x && haloMax.y >= boundsMax.y && haloMax.z >= boundsMax.z;
+
+			// gather the points of every tile that the halo overlaps
+			voro::pre_container preContainer(haloMin.x, haloMax.x, haloMin.y, haloMax.y, haloMin.z, haloMax.z, false, false, false);
+			for( int z = tileCoord(haloMin.z, boundsMin.z, tileSize.z); z <= tileCoord(haloMax.z, boundsMin.z, tileSize.z); ++z ) {
+				for( int y = tileCoord(haloMin.y, boundsMin.y, tileSize.y); y <= tileCoord(haloMax.y, boundsMin.y, tileSize.y); ++y ) {
+					for( int x = tileCoord(haloMin.x, boundsMin.x, tileSize.x); x <= tileCoord(haloMax.x, boundsMin.x, tileSize.x); ++x ) {
+						for( const int idx : tilePoints[x + tilesPerAxis * (y + tilesPerAxis * z)] ) {
+							const cc::Vec3f& pos = samplePoints[idx];
+							if( pos.x < haloMin.x || pos.x > haloMax.x || pos.y < haloMin.y || pos.y > haloMax.y || pos.z < haloMin.z || pos.z > haloMax.z ) {
+								continue;
+							}
+							preContainer.put(idx, static_cast<double>(pos.x), static_cast<double>(pos.y), static_cast<double>(pos.z));
+						}
+					}
 				}
+			}
+			int resx = 0;
+			int resy = 0;
+			int resz = 0;
+			preContainer.guess_optimal(resx, resy, resz);
+			const int initMem = 8;
+			voro::container container(haloMin.x, haloMax.x, haloMin.y, haloMax.y, haloMin.z, haloMax.z, resx, resy, resz, false, false, false, initMem);
+			preContainer.setup(container);
+			for( auto& wall : walls ) {
+				container.add_wall(*wall);
+			}
 
-				// extract planes from points
-				std::vector<int> faceVertices;
-				cell.face_vertices(faceVertices);
-				int faceCounter = 0;
-				for( int i = 0;  i < faceVertices.size(); ) {
-					const int vertsInFace = faceVertices[i]; // k, k+k1, k+k1+k2, ...
-
-					cc::Vec3f faceCenter;
-					std::vector<cc::Vec3f> facePoints;
-					for( int j = i+1; j < i+vertsInFace+1; ++j ) {
-						const int vtxIdx = faceVertices[j];
-						facePoints.push_back(cellPoints[vtxIdx]);
-						faceCenter += cellPoints[vtxIdx];
-						newCell.addPoint(cellPoints[vtxIdx]);
-						newCell.addIndex(vtxIdx);
+			// compute the pending cells, keeping back any that reach too close to a side of the halo inside of the container
+			std::vector<int> retry;
+			voro::voro_compute<voro::container> compute(container, container.nx, container.ny, container.nz);
+			for( int ijk = 0; ijk < container.nxyz; ++ijk ) {
+				const int k = ijk / container.nxy;
+				const int j = (ijk - container.nxy * k) / container.nx;
+				const int i = ijk - container.nxy * k - container.nx * j;
+				for( int q = 0; q < container.co[ijk]; ++q ) {
+					const int id = container.id[ijk][q];
+					if( !std::binary_search(pending.begin(), pending.end(), id) ) {
+						continue;
 					}
-					newCell.addPlanePoints(facePoints);
-					faceCenter /= static_cast<float>(facePoints.size());
-					newCell.addCount(facePoints.size());
-
-					Plane plane;
-					if( PlaneHelper::planeFromPoints(facePoints, plane) ) {
-						plane.pointOnPlane = faceCenter;
-						newCell.addPlane(plane);
+					if( !compute.compute_cell(scratch.cell, ijk, q, i, j, k) ) {
+						continue;
 					}
-
-					i += vertsInFace+1;
-					faceCounter += 1;
+					const double* pp = container.p[ijk] + container.ps * q;
+					if( !isWhole ) {
+						// voro++ stores vertices at twice their offset from the seed, so this is twice the cell's radius
+						const double reach = sqrt(scratch.cell.max_radius_squared());
+						const bool tooClose = (haloMin.x > boundsMin.x && pp[0] - haloMin.x < reach) || (haloMax.x < boundsMax.x && haloMax.x - pp[0] < reach) ||
+						                      (haloMin.y > boundsMin.y && pp[1] - haloMin.y < reach) || (haloMax.y < boundsMax.y && haloMax.y - pp[1] < reach) ||
+						                      (haloMin.z > boundsMin.z && pp[2] - haloMin.z < reach) || (haloMax.z < boundsMax.z && haloMax.z - pp[2] < reach);
+						if( tooClose ) {
+							retry.push_back(id);
+							continue;
+						}
+					}
+					VoroHelper::convertCell(container, samplePoints, nullptr, id, pp[0], pp[1], pp[2], info, scratch);
+					++cellCount;
+					visitor(id, scratch.outCell);
 				}
-
-				outCells.push_back(newCell);
 			}
-		} while(cla.inc());
-	}
+			std::sort(retry.begin(), retry.end());
+			pending.swap(retry);
+		}
+	};
 
-	//container.draw_cells_gnuplot("C:/Users/daniel/Desktop/cells.gnu");
-	//container.draw_particles("C:/Users/daniel/Desktop/particles.gnu");
+	// tiles are independent, so threads take whole tiles.  only as many tiles as there are threads are held at once.
+	parallelFor(info.threadCount, tileCount, computeTile);
 
-	return !outCells.empty();
+	return cellCount > 0;
 }
\ No newline at end of file
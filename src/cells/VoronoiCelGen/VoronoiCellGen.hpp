@@ -8,7 +8,20 @@ public:
 	VoronoiCellGen();
 	~VoronoiCellGen();
 
-	virtual bool generate( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, std::vector<Cell>& outCells ) const override;
+	virtual bool generateEach( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const override;
+
+private:
+	/**
+	 * Generates cells one tile of space at a time, so that only a tile's worth of sample points are ever held in a container.
+	 * Each tile's container covers the tile plus a halo of the points around it, and only the cells of points within the
+	 * tile itself are emitted.  Cells that the halo was too thin to be sure of are computed again with a thicker one.
+	 * @param[in] bbox         BoundingBox to clamp cell generation to.
+	 * @param[in] samplePoints Sample points used to seed cell generation.
+	 * @param[in] info         Info to be used for generation.
+	 * @param[in] visitor      Visitor to invoke for each generated Cell.
+	 * @returns True if any cells were generated; false otherwise.
+	 */
+	bool generateTiled( const BoundingBox& bbox, const std::vector<cc::Vec3f>& samplePoints, const CellGenInfo& info, const CellVisitor& visitor ) const;
 };
 
 #endif /* __voronoi_plane_generator__ */
\ No newline at end of file
@@ -7,18 +7,28 @@
 #include <maya/MDagPath.h>
 #include "Syntax.hpp"
 #include "MayaHelper.hpp"
+#include "PlaneHelper.hpp"
 #include "points/PointGenFactory.hpp"
 #include "cells/CellGenFactory.hpp"
+#include "cells/PatternCellGen/CellPattern.hpp"
+#include "cells/CellSimplifier.hpp"
+#include "cells/LloydRelaxer.hpp"
+#include "cells/ConvexRegion.hpp"
+#include "ParallelFor.hpp"
+#include "cells/SlabCellGen/SlabCellGen.hpp"
+#include "ChunkAdjacency.hpp"
+#include "MeshInsideTest.hpp"
 #include "slicing/MeshSlicerFactory.hpp"
 #include <maya/MFnSet.h>
 #include "MTLog.hpp"
 #include <thread>
+#include <algorithm>
 #include "slicing/CSGSlicer/CSGSlicer.hpp"
 
 static std::mutex GeneratedMeshesMutex;
 
 Hadan::Hadan()
-	: MPxCommand(), _inputMesh(), _pointsGenType(PointGenFactory::Type::Invalid), _separationDistance(0.0), _pointGenInfo(), _useMultithreading(false) {
+	: MPxCommand(), _inputMesh(), _pointsGenType(PointGenFactory::Type::Invalid), _separationDistance(0.0), _pointGenInfo(), _useMultithreading(false), _cullExterior(false), _insideMesh(false), _useColorWeights(false), _cellGenType(CellGenFactory::Type::Voronoi), _useSession(false), _session(nullptr), _reusedChunkCount(0), _depth(1), _relaxIterations(0), _splitMesh(false), _useAdjacency(false), _cuttingCellCount(0) {
 }
 
 Hadan::~Hadan() {
@@ -40,6 +50,16 @@ MStatus Hadan::doIt( const MArgList& args ) {
 		return MS::kFailure;
 	}
 
+	// save a pattern instead of fracturing
+	if( !_savePatternPath.empty() ) {
+		if( !savePattern() ) {
+			MTLog::instance()->log("Error: Failed to save cell pattern.\n");
+			return MS::kFailure;
+		}
+		MTLog::instance()->log("Saved cell pattern to " + _savePatternPath + ".\n");
+		return MS::kSuccess;
+	}
+
 	// clear all selections as some MEL commands dislike things being selected
 	MGlobal::clearSelectionList();
 
@@ -52,20 +72,96 @@ MStatus Hadan::doIt( const MArgList& args ) {
 	// get the bounding box from Maya
 	_boundingBox = MayaHelper::getBoundingBox(MFnMesh(_inputMesh));
 
-	// generate sample points
-	if( !generateSamplePoints() ) {
+	// generate sample points (patterns and given cutting planes bring their own cells)
+	if( usesSamplePoints() && !generateSamplePoints() ) {
 		MTLog::instance()->log("Error: Not enough sample points were generated.\n");
 		return MS::kFailure;
 	}
 
-	// generating cutting cells
-	if( !generateCuttingCells() ) {
-		MTLog::instance()->log("Error: Generated cutting cells were inadequate.\n");
+	// drop sample points outside of the mesh and hug cells to it
+	if( _cullExterior && usesSamplePoints() && !cullExterior() ) {
+		MTLog::instance()->log("Error: No sample points were inside of the mesh.\n");
+		return MS::kFailure;
+	}
+
+	// relax sample points so that cells are evenly shaped
+	if( _relaxIterations > 0 && usesSamplePoints() && !relaxSamplePoints() ) {
+		MTLog::instance()->log("Error: Failed to relax sample points.\n");
 		return MS::kFailure;
 	}
 
-	// cut out all cells, creating a new piece of geometry for each
-	performCutting();
+	// create the slicer from the input mesh
+	std::shared_ptr<IMeshSlicer> slicer = createSlicer();
+	if( nullptr == slicer ) {
+		MTLog::instance()->log("Error: Failed to set slicer mesh source.\n");
+		return MS::kFailure;
+	}
+
+	// only generate the parts of each cell that the slicer reads
+	_cellGenInfo.needsPlanes = slicer->needsCellPlanes();
+	_cellGenInfo.needsFaces = slicer->needsCellFaces();
+
+	// simplification reads both, and outputs both
+	if( CellSimplifier(_cellGenInfo).isEnabled() ) {
+		_cellGenInfo.needsPlanes = true;
+		_cellGenInfo.needsFaces = true;
+	}
+
+	// slabs split from the mesh itself have no cells to track or measure contacts between
+	if( _splitMesh && (CellGenFactory::Type::Slab != _cellGenType || _useSession || !_adjacencyPath.empty() || _depth > 1) ) {
+		MTLog::instance()->log("Warning: -splitMesh (-spm) is ignored without slab cells, or with a -session (-ses), -adjacency (-adj), or -depth (-dep) above 1.\n");
+		_splitMesh = false;
+	}
+
+	// continue the mesh's session (cells without sample points have no seeds to track), re-slicing only cells that changed
+	_session = nullptr;
+	if( _useSession && _depth > 1 ) {
+		MTLog::instance()->log("Warning: -session (-ses) is ignored when fracturing with a -depth (-dep) above 1.\n");
+	} else if( _useSession && usesSamplePoints() ) {
+		_session = &HadanSession::get(MFnDagNode(_inputMesh).fullPathName().asChar());
+		_session->validate(sessionFingerprint());
+		_session->pruneDeadChunks();
+		_sessionCells.clear();
+		// cells' neighbors are read from their planes, and their corners from their faces
+		_cellGenInfo.needsPlanes = true;
+		_cellGenInfo.needsFaces = true;
+	}
+
+	// measure contacts between chunks as they are cut (cells' neighbors are read from their planes)
+	_useAdjacency = false;
+	if( !_adjacencyPath.empty() ) {
+		// slab and lattice planes border many cells at once, so they have no single neighbor to record
+		const bool hasNeighbors = CellGenFactory::Type::Slab != _cellGenType && CellGenFactory::Type::Grid != _cellGenType && CellGenFactory::Type::Brick != _cellGenType && CellGenFactory::Type::Hex != _cellGenType;
+		if( _depth > 1 || _session != nullptr ) {
+			MTLog::instance()->log("Warning: -adjacency (-adj) is ignored when fracturing with a -depth (-dep) above 1 or a -session (-ses).\n");
+		} else if( !hasNeighbors ) {
+			MTLog::instance()->log("Warning: -adjacency (-adj) is ignored with slab, grid, brick, or hex cells, which do not record the cell across each of their planes.\n");
+		} else {
+			_useAdjacency = true;
+			_adjacency.clear();
+			_adjacencyChunks.clear();
+			_cellGenInfo.needsPlanes = true;
+			// merged faces keep only one of their neighbors, and dropped faces lose theirs
+			if( CellSimplifier(_cellGenInfo).isEnabled() ) {
+				MTLog::instance()->log("Warning: -adjacency (-adj) misses contacts across faces merged or dropped by -minFaceArea (-mfa) or -mergeAngle (-mga).\n");
+			}
+		}
+	}
+
+	// generate cutting cells, cutting out each one as soon as it is generated and creating a new piece of geometry for each
+	// (or, when recursing or splitting slabs from the mesh, fracturing the pieces in core and only creating geometry for the final pieces)
+	bool cellsGenerated = false;
+	if( _depth > 1 ) {
+		cellsGenerated = generateAndCutCellsRecursively(slicer);
+	} else if( _splitMesh ) {
+		cellsGenerated = splitMeshIntoSlabs();
+	} else {
+		cellsGenerated = generateAndCutCells(slicer);
+	}
+	if( !cellsGenerated ) {
+		MTLog::instance()->log("Error: Generated cutting cells were inadequate.\n");
+		return MS::kFailure;
+	}
 
 	// clear selection
 	MGlobal::clearSelectionList();
@@ -76,16 +172,31 @@ MStatus Hadan::doIt( const MArgList& args ) {
 	// apply default material to all generated cells
 	applyMaterials();
 
-	// create parent group for the shards
+	// create parent group for the shards, or keep adding to the session's group
 	MFnTransform parentXform;
-	parentXform.create();
-	parentXform.setName(MFnDagNode(_inputMesh).name() + "_chunks");
+	if( _session != nullptr && !_session->getGroup().isNull() ) {
+		parentXform.setObject(_session->getGroup());
+	} else {
+		parentXform.create();
+		parentXform.setName(MFnDagNode(_inputMesh).name() + "_chunks");
+	}
 
 	// parent all chunks to the parent xform (this will make a new one if it already exists like maya does)
 	for( auto& curr : _generatedMeshes ) {
 		parentXform.addChild(MFnDagNode(curr).parent(0));
 	}
 
+	// write which chunks touch, named by their transforms now that they are parented
+	if( _useAdjacency ) {
+		saveAdjacency();
+	}
+
+	// replace the session's cells with this run's, deleting chunks that were not reused
+	if( _session != nullptr ) {
+		_session->getGroup() = parentXform.object();
+		_session->commit(_sessionCells);
+	}
+
 	// shrink vertices of chunks along normals
 	//separateCells();
 
@@ -96,7 +207,11 @@ MStatus Hadan::doIt( const MArgList& args ) {
 	const auto endTime = std::chrono::system_clock::now();
 	const std::chrono::duration<double> timeDiff = endTime - startTime;
 	const std::string timeTakenStr = "Hadan finished in " + std::to_string(timeDiff.count()) + "s. ";
-	const std::string chunkStr = std::to_string(_generatedMeshes.size()) + "/" + std::to_string(_cuttingCells.size()) + " chunks generated.\n";
+	std::string chunkStr = std::to_string(_generatedMeshes.size()) + "/" + std::to_string(_cuttingCellCount) + " chunks generated";
+	if( _session != nullptr ) {
+		chunkStr += " (" + std::to_string(_reusedChunkCount) + " cells unchanged from the previous run)";
+	}
+	chunkStr += ".\n";
 	MTLog::instance()->log(timeTakenStr + chunkStr);
 
 	return MStatus::kSuccess;
@@ -130,52 +245,191 @@ bool Hadan::parseArgs( const MArgList& args ) {
 	_separationDistance = 0.0;
 	_pointGenInfo = PointGenInfo();
 
-	// parse and validate existance of mesh name
-	if( !db.isFlagSet(HadanArgs::HadanMeshName) ) {
-		MTLog::instance()->log("Error: Required argument -meshName (-mn) is missing.\n");
-		return false;
+	// parse pattern saving and loading, which change which arguments are required
+	_savePatternPath.clear();
+	if( db.isFlagSet(HadanArgs::HadanSavePattern) ) {
+		MString savePatternStr;
+		db.getFlagArgument(HadanArgs::HadanSavePattern, 0, savePatternStr);
+		_savePatternPath = savePatternStr.asChar();
 	}
-	MString meshNameStr;
-	db.getFlagArgument(HadanArgs::HadanMeshName, 0, meshNameStr);
-	if( !MayaHelper::getObjectFromString(meshNameStr.asChar(), _inputMesh) ) {
-		MTLog::instance()->log("Error: Given object not found.\n");
-		return false;
+	_cellGenInfo.patternPath.clear();
+	if( db.isFlagSet(HadanArgs::HadanPattern) ) {
+		MString patternStr;
+		db.getFlagArgument(HadanArgs::HadanPattern, 0, patternStr);
+		_cellGenInfo.patternPath = patternStr.asChar();
 	}
+	const bool savingPattern = !_savePatternPath.empty();
+	const bool loadingPattern = !_cellGenInfo.patternPath.empty();
 
-	// parse fracture type
-	if( !db.isFlagSet(HadanArgs::HadanFractureType) ) {
-		MTLog::instance()->log("Error: Required argument -fractureType (-ft) is missing.\n");
-		return false;
+	// parse cutting planes, which also make sample points unnecessary
+	_cellGenInfo.cutPlanes.clear();
+	const unsigned int cutPlaneUses = db.numberOfFlagUses(HadanArgs::HadanCutPlane);
+	for( unsigned int i = 0; i < cutPlaneUses; ++i ) {
+		MArgList cutPlaneArgsList;
+		db.getFlagArgumentList(HadanArgs::HadanCutPlane, i, cutPlaneArgsList);
+		if( cutPlaneArgsList.length() != 6 ) {
+			MTLog::instance()->log("Ignoring -cpl (-cutPlane) " + std::to_string(i) + " because it was formatted incorrectly.\n");
+			continue;
+		}
+		unsigned int argIndex = 0;
+		const MVector point = cutPlaneArgsList.asVector(argIndex, 3);
+		const MVector normal = cutPlaneArgsList.asVector(argIndex, 3);
+		if( normal.length() <= 0.0 ) {
+			MTLog::instance()->log("Ignoring -cpl (-cutPlane) " + std::to_string(i) + " because its normal is zero.\n");
+			continue;
+		}
+		const cc::Vec3f pointOnPlane(static_cast<float>(point.x), static_cast<float>(point.y), static_cast<float>(point.z));
+		Plane plane = Plane::constructFromPointNormal(pointOnPlane, cc::Vec3f(static_cast<float>(normal.x), static_cast<float>(normal.y), static_cast<float>(normal.z)));
+		plane.pointOnPlane = pointOnPlane;
+		_cellGenInfo.cutPlanes.push_back(plane);
 	}
-	MString fractureTypeStr;
-	db.getFlagArgument(HadanArgs::HadanFractureType, 0, fractureTypeStr);
-	if( strcmp(fractureTypeStr.asChar(), "uniform") == 0 ) {
-		_pointsGenType = PointGenFactory::Type::Uniform;
-	} else if( strcmp(fractureTypeStr.asChar(), "bezier") == 0 ) {
-		_pointsGenType = PointGenFactory::Type::Bezier;
-	} else if( strcmp(fractureTypeStr.asChar(), "cluster") == 0 ) {
-		_pointsGenType = PointGenFactory::Type::Cluster;
-	} else if( strcmp(fractureTypeStr.asChar(), "test") == 0 ) {
-		_pointsGenType = PointGenFactory::Type::Test;
-	} else {
-		MTLog::instance()->log("Error: Unknown fracture type.\n");
-		return false;
+	const bool cuttingWithPlanes = !_cellGenInfo.cutPlanes.empty();
+
+	// parse slab mesh splitting
+	_splitMesh = false;
+	if( db.isFlagSet(HadanArgs::HadanSplitMesh) ) {
+		db.getFlagArgument(HadanArgs::HadanSplitMesh, 0, _splitMesh);
 	}
 
-	// parse slicer type
-	if( !db.isFlagSet(HadanArgs::HadanSlicerType) ) {
-		MTLog::instance()->log("Error: Required argument -slicerType (-st) is missing.\n");
-		return false;
+	// mesh is not needed when only saving a pattern
+	if( !savingPattern ) {
+		// parse and validate existance of mesh name
+		if( !db.isFlagSet(HadanArgs::HadanMeshName) ) {
+			MTLog::instance()->log("Error: Required argument -meshName (-mn) is missing.\n");
+			return false;
+		}
+		MString meshNameStr;
+		db.getFlagArgument(HadanArgs::HadanMeshName, 0, meshNameStr);
+		if( !MayaHelper::getObjectFromString(meshNameStr.asChar(), _inputMesh) ) {
+			MTLog::instance()->log("Error: Given object not found.\n");
+			return false;
+		}
 	}
-	MString slicerTypeStr;
-	db.getFlagArgument(HadanArgs::HadanSlicerType, 0, slicerTypeStr);
-	if( strcmp(slicerTypeStr.asChar(), "gte") == 0 ) {
-		_slicerType = MeshSlicerFactory::Type::GTE;
-	} else if( strcmp(slicerTypeStr.asChar(), "csgjs") == 0 ) {
-		_slicerType = MeshSlicerFactory::Type::CSGJS;
-	} else {
-		MTLog::instance()->log("Error: Unknown slicer type.");
-		return false;
+
+	// parse cell type
+	_cellGenType = CellGenFactory::Type::Voronoi;
+	if( db.isFlagSet(HadanArgs::HadanCellType) ) {
+		MString cellTypeStr;
+		db.getFlagArgument(HadanArgs::HadanCellType, 0, cellTypeStr);
+		if( strcmp(cellTypeStr.asChar(), "voronoi") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Voronoi;
+		} else if( strcmp(cellTypeStr.asChar(), "power") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Power;
+		} else if( strcmp(cellTypeStr.asChar(), "slab") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Slab;
+		} else if( strcmp(cellTypeStr.asChar(), "grid") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Grid;
+		} else if( strcmp(cellTypeStr.asChar(), "brick") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Brick;
+		} else if( strcmp(cellTypeStr.asChar(), "hex") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Hex;
+		} else if( strcmp(cellTypeStr.asChar(), "radial") == 0 ) {
+			_cellGenType = CellGenFactory::Type::Radial;
+		} else {
+			MTLog::instance()->log("Error: Unknown cell type.\n");
+			return false;
+		}
+	}
+
+	if( loadingPattern && !savingPattern ) {
+		_cellGenType = CellGenFactory::Type::Pattern;
+	} else if( cuttingWithPlanes ) {
+		_cellGenType = CellGenFactory::Type::Slab;
+	}
+
+	// fracture type is not needed when cells come from a pattern, cutting planes, a lattice, or an impact point
+	if( !loadingPattern && usesSamplePoints() ) {
+		// parse fracture type
+		if( !db.isFlagSet(HadanArgs::HadanFractureType) ) {
+			MTLog::instance()->log("Error: Required argument -fractureType (-ft) is missing.\n");
+			return false;
+		}
+		MString fractureTypeStr;
+		db.getFlagArgument(HadanArgs::HadanFractureType, 0, fractureTypeStr);
+		if( strcmp(fractureTypeStr.asChar(), "uniform") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Uniform;
+		} else if( strcmp(fractureTypeStr.asChar(), "bezier") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Bezier;
+		} else if( strcmp(fractureTypeStr.asChar(), "cluster") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Cluster;
+		} else if( strcmp(fractureTypeStr.asChar(), "test") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Test;
+		} else if( strcmp(fractureTypeStr.asChar(), "poisson") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Poisson;
+		} else if( strcmp(fractureTypeStr.asChar(), "surface") == 0 ) {
+			_pointsGenType = PointGenFactory::Type::Surface;
+		} else {
+			MTLog::instance()->log("Error: Unknown fracture type.\n");
+			return false;
+		}
+	}
+
+	// slicer is not needed when only saving a pattern
+	if( !savingPattern ) {
+		// parse slicer type
+		if( !db.isFlagSet(HadanArgs::HadanSlicerType) ) {
+			MTLog::instance()->log("Error: Required argument -slicerType (-st) is missing.\n");
+			return false;
+		}
+		MString slicerTypeStr;
+		db.getFlagArgument(HadanArgs::HadanSlicerType, 0, slicerTypeStr);
+		if( strcmp(slicerTypeStr.asChar(), "gte") == 0 ) {
+			_slicerType = MeshSlicerFactory::Type::GTE;
+		} else if( strcmp(slicerTypeStr.asChar(), "csgjs") == 0 ) {
+			_slicerType = MeshSlicerFactory::Type::CSGJS;
+		} else {
+			MTLog::instance()->log("Error: Unknown slicer type.");
+			return false;
+		}
+	}
+
+	// parse pattern tiles
+	if( db.isFlagSet(HadanArgs::HadanPatternTiles) ) {
+		db.getFlagArgument(HadanArgs::HadanPatternTiles, 0, _cellGenInfo.patternTiles);
+	}
+
+	// parse pattern rotation
+	if( db.isFlagSet(HadanArgs::HadanPatternRotation) ) {
+		double rx = 0.0;
+		double ry = 0.0;
+		double rz = 0.0;
+		db.getFlagArgument(HadanArgs::HadanPatternRotation, 0, rx);
+		db.getFlagArgument(HadanArgs::HadanPatternRotation, 1, ry);
+		db.getFlagArgument(HadanArgs::HadanPatternRotation, 2, rz);
+		_cellGenInfo.patternRotation = cc::Vec3f(static_cast<float>(rx), static_cast<float>(ry), static_cast<float>(rz));
+	}
+
+	// parse lattice counts and jitter
+	_cellGenInfo.latticeCounts[0] = _cellGenInfo.latticeCounts[1] = _cellGenInfo.latticeCounts[2] = 1;
+	_cellGenInfo.latticeJitter = 0.0;
+	if( db.isFlagSet(HadanArgs::HadanLatticeCount) ) {
+		for( unsigned int i = 0; i < 3; ++i ) {
+			db.getFlagArgument(HadanArgs::HadanLatticeCount, i, _cellGenInfo.latticeCounts[i]);
+			_cellGenInfo.latticeCounts[i] = std::max<unsigned int>(1, _cellGenInfo.latticeCounts[i]);
+		}
+	}
+	if( db.isFlagSet(HadanArgs::HadanLatticeJitter) ) {
+		db.getFlagArgument(HadanArgs::HadanLatticeJitter, 0, _cellGenInfo.latticeJitter);
+		_cellGenInfo.latticeJitter = cc::math::clamp<double>(_cellGenInfo.latticeJitter, 0.0, 100.0);
+	}
+
+	// parse radial cracks and rings
+	_cellGenInfo.radialWedges = 12;
+	_cellGenInfo.radialRings = 6;
+	_cellGenInfo.radialGrowth = 1.4;
+	_cellGenInfo.radialJitter = 0.0;
+	if( db.isFlagSet(HadanArgs::HadanWedgeCount) ) {
+		db.getFlagArgument(HadanArgs::HadanWedgeCount, 0, _cellGenInfo.radialWedges);
+	}
+	if( db.isFlagSet(HadanArgs::HadanRingCount) ) {
+		db.getFlagArgument(HadanArgs::HadanRingCount, 0, _cellGenInfo.radialRings);
+	}
+	if( db.isFlagSet(HadanArgs::HadanRingGrowth) ) {
+		db.getFlagArgument(HadanArgs::HadanRingGrowth, 0, _cellGenInfo.radialGrowth);
+	}
+	if( db.isFlagSet(HadanArgs::HadanRadialJitter) ) {
+		db.getFlagArgument(HadanArgs::HadanRadialJitter, 0, _cellGenInfo.radialJitter);
+		_cellGenInfo.radialJitter = cc::math::clamp<double>(_cellGenInfo.radialJitter, 0.0, 100.0);
 	}
 
 	// parse separation distance
@@ -198,6 +452,13 @@ bool Hadan::parseArgs( const MArgList& args ) {
 
 	// parse random seed
 	db.getFlagArgument(HadanArgs::HadanRandomSeed, 0, _pointGenInfo.seed);
+	_cellGenInfo.seed = _pointGenInfo.seed;
+
+	// parse radius percent
+	if( db.isFlagSet(HadanArgs::HadanRadiusPercentage) ) {
+		db.getFlagArgument(HadanArgs::HadanRadiusPercentage, 0, _pointGenInfo.radiusPercent);
+		_pointGenInfo.radiusPercent = cc::math::clamp<double>(_pointGenInfo.radiusPercent, 0.0, 100.0);
+	}
 
 	// parse smoothing angle
 	if( db.isFlagSet(HadanArgs::HadanSmoothingAngle) ) {
@@ -210,10 +471,92 @@ bool Hadan::parseArgs( const MArgList& args ) {
 		_pointGenInfo.minBezierDistance = cc::math::clamp<double>(_pointGenInfo.minBezierDistance, 0.0, 100.0);
 	}
 
+	// parse poisson spacing and tile
+	if( db.isFlagSet(HadanArgs::HadanMinSpacing) ) {
+		db.getFlagArgument(HadanArgs::HadanMinSpacing, 0, _pointGenInfo.minSpacing);
+		_pointGenInfo.minSpacing = cc::math::clamp<double>(_pointGenInfo.minSpacing, 0.0, 100.0);
+	}
+	if( db.isFlagSet(HadanArgs::HadanBlueNoiseTile) ) {
+		MString blueNoiseTileStr;
+		db.getFlagArgument(HadanArgs::HadanBlueNoiseTile, 0, blueNoiseTileStr);
+		_pointGenInfo.blueNoiseTilePath = blueNoiseTileStr.asChar();
+	}
+
 	// parse multi-threading
 	if( db.isFlagSet(HadanArgs::HadanMultiThreading) ) {
 		db.getFlagArgument(HadanArgs::HadanMultiThreading, 0, _useMultithreading);
 	}
+	_cellGenInfo.threadCount = _useMultithreading ? std::max<unsigned int>(1, std::thread::hardware_concurrency()) : 1;
+	_pointGenInfo.threadCount = _cellGenInfo.threadCount;
+
+	// parse relaxation
+	_relaxIterations = 0;
+	if( db.isFlagSet(HadanArgs::HadanRelaxIterations) ) {
+		db.getFlagArgument(HadanArgs::HadanRelaxIterations, 0, _relaxIterations);
+	}
+
+	// parse cell simplification
+	_cellGenInfo.minFaceAreaPercent = 0.0;
+	if( db.isFlagSet(HadanArgs::HadanMinFaceArea) ) {
+		db.getFlagArgument(HadanArgs::HadanMinFaceArea, 0, _cellGenInfo.minFaceAreaPercent);
+		_cellGenInfo.minFaceAreaPercent = cc::math::clamp<double>(_cellGenInfo.minFaceAreaPercent, 0.0, 100.0);
+	}
+	_cellGenInfo.mergeAngle = 0.0;
+	if( db.isFlagSet(HadanArgs::HadanMergeAngle) ) {
+		db.getFlagArgument(HadanArgs::HadanMergeAngle, 0, _cellGenInfo.mergeAngle);
+		_cellGenInfo.mergeAngle = cc::math::clamp<double>(_cellGenInfo.mergeAngle, 0.0, 90.0);
+	}
+
+	// parse voronoi tiling
+	_cellGenInfo.tileSeedCount = 0;
+	if( db.isFlagSet(HadanArgs::HadanTileSeeds) ) {
+		db.getFlagArgument(HadanArgs::HadanTileSeeds, 0, _cellGenInfo.tileSeedCount);
+	}
+
+	// parse adjacency graph output
+	_adjacencyPath.clear();
+	if( db.isFlagSet(HadanArgs::HadanAdjacency) ) {
+		MString adjacencyStr;
+		db.getFlagArgument(HadanArgs::HadanAdjacency, 0, adjacencyStr);
+		_adjacencyPath = adjacencyStr.asChar();
+	}
+
+	// parse session
+	if( db.isFlagSet(HadanArgs::HadanSession) ) {
+		db.getFlagArgument(HadanArgs::HadanSession, 0, _useSession);
+	}
+
+	// parse exterior culling
+	if( db.isFlagSet(HadanArgs::HadanCullExterior) ) {
+		db.getFlagArgument(HadanArgs::HadanCullExterior, 0, _cullExterior);
+	}
+	if( db.isFlagSet(HadanArgs::HadanInsideMesh) ) {
+		db.getFlagArgument(HadanArgs::HadanInsideMesh, 0, _insideMesh);
+	}
+
+	// parse surface sampling
+	if( db.isFlagSet(HadanArgs::HadanSurfaceDepth) ) {
+		db.getFlagArgument(HadanArgs::HadanSurfaceDepth, 0, _pointGenInfo.surfaceDepth);
+		_pointGenInfo.surfaceDepth = cc::math::clamp<double>(_pointGenInfo.surfaceDepth, 0.0, 100.0);
+	}
+	if( db.isFlagSet(HadanArgs::HadanColorWeight) ) {
+		db.getFlagArgument(HadanArgs::HadanColorWeight, 0, _useColorWeights);
+	}
+
+	// parse recursive fracturing depth and per-level counts
+	_depth = 1;
+	if( db.isFlagSet(HadanArgs::HadanDepth) ) {
+		db.getFlagArgument(HadanArgs::HadanDepth, 0, _depth);
+		_depth = std::max<unsigned int>(1, _depth);
+	}
+	_levelCounts.clear();
+	const unsigned int levelCountUses = db.numberOfFlagUses(HadanArgs::HadanLevelCount);
+	for( unsigned int i = 0; i < levelCountUses; ++i ) {
+		MArgList levelCountArgsList;
+		db.getFlagArgumentList(HadanArgs::HadanLevelCount, i, levelCountArgsList);
+		unsigned int dummyIndex = 0;
+		_levelCounts.push_back(static_cast<unsigned int>(levelCountArgsList.asInt(dummyIndex)));
+	}
 
 	// parse user's optional points list
 	const unsigned int pntUses = db.numberOfFlagUses(HadanArgs::HadanPoint);
@@ -229,9 +572,45 @@ bool Hadan::parseArgs( const MArgList& args ) {
 		_pointGenInfo.userPoints.push_back(cc::Vec3f(static_cast<float>(vector.x), static_cast<float>(vector.y), static_cast<float>(vector.z)));
 	}
 
+	// parse bezier cracks, each taking its points from the next of the user's points
+	const unsigned int crackUses = db.numberOfFlagUses(HadanArgs::HadanCrack);
+	size_t crackPointIndex = 0;
+	for( unsigned int i = 0; i < crackUses; ++i ) {
+		MArgList crackArgsList;
+		db.getFlagArgumentList(HadanArgs::HadanCrack, i, crackArgsList);
+		if( crackArgsList.length() != 3 ) {
+			MTLog::instance()->log("Ignoring -crk (-crack) " + std::to_string(i) + " because it was formatted incorrectly.\n");
+			continue;
+		}
+		unsigned int argIndex = 0;
+		const size_t pointCount = static_cast<size_t>(crackArgsList.asInt(argIndex));
+		PointGenInfo::CrackInfo crack;
+		crack.samples = static_cast<unsigned int>(crackArgsList.asInt(argIndex));
+		crack.flux = crackArgsList.asDouble(argIndex);
+		if( crackPointIndex + pointCount > _pointGenInfo.userPoints.size() ) {
+			MTLog::instance()->log("Ignoring -crk (-crack) " + std::to_string(i) + " because too few -pnt (-point)s are left for it.\n");
+			continue;
+		}
+		crack.controlPoints.assign(_pointGenInfo.userPoints.begin() + crackPointIndex, _pointGenInfo.userPoints.begin() + crackPointIndex + pointCount);
+		crackPointIndex += pointCount;
+		_pointGenInfo.cracks.push_back(crack);
+	}
+
+	// radial cells shatter out from the first point
+	_cellGenInfo.hasImpactPoint = !_pointGenInfo.userPoints.empty();
+	if( _cellGenInfo.hasImpactPoint ) {
+		_cellGenInfo.impactPoint = _pointGenInfo.userPoints[0];
+	}
+
 	return true;
 }
 
+bool Hadan::usesSamplePoints() const {
+	const bool cuttingWithPlanes = (CellGenFactory::Type::Slab == _cellGenType) && !_cellGenInfo.cutPlanes.empty();
+	const bool isLattice = (CellGenFactory::Type::Grid == _cellGenType) || (CellGenFactory::Type::Brick == _cellGenType) || (CellGenFactory::Type::Hex == _cellGenType);
+	return (CellGenFactory::Type::Pattern != _cellGenType) && (CellGenFactory::Type::Radial != _cellGenType) && !cuttingWithPlanes && !isLattice;
+}
+
 bool Hadan::validateInputMesh() const {
 	MFnMesh mesh(_inputMesh);
 
@@ -257,50 +636,587 @@ bool Hadan::validateInputMesh() const {
 }
 
 bool Hadan::generateSamplePoints() {
+	// patterns cover the unit cube rather than the mesh, so they are never kept inside of it
+	if( _insideMesh && _savePatternPath.empty() && nullptr == _pointGenInfo.insideMesh ) {
+		MDagPath meshPath = _inputMesh;
+		Model sourceModel;
+		MayaHelper::copyMFnMeshToModel(meshPath, sourceModel);
+		std::shared_ptr<MeshInsideTest> insideTest = std::make_shared<MeshInsideTest>();
+		if( insideTest->build(sourceModel) ) {
+			_pointGenInfo.insideMesh = insideTest;
+		}
+	}
+
+	// surface points are sampled over the mesh's triangles, optionally weighted by its painted vertex colors
+	if( PointGenFactory::Type::Surface == _pointsGenType && _savePatternPath.empty() && nullptr == _pointGenInfo.surfaceModel ) {
+		MDagPath meshPath = _inputMesh;
+		std::shared_ptr<Model> surfaceModel = std::make_shared<Model>();
+		MayaHelper::copyMFnMeshToModel(meshPath, *surfaceModel);
+		_pointGenInfo.surfaceModel = surfaceModel;
+		if( _useColorWeights && !MayaHelper::getVertexColorWeights(meshPath, _pointGenInfo.surfaceWeights) ) {
+			MTLog::instance()->log("Warning: Mesh has no vertex colors.  Sampling its surface by area alone.\n");
+			_pointGenInfo.surfaceWeights.clear();
+		}
+	}
+
 	std::unique_ptr<IPointGen> gen = PointGenFactory::create(_pointsGenType);
 	gen->generateSamplePoints(_boundingBox, _pointGenInfo, _samplePoints);
+
+	// power cells are weighted by a radius per point
+	_cellGenInfo.sampleRadii.clear();
+	if( CellGenFactory::Type::Power == _cellGenType ) {
+		gen->generateSampleRadii(_boundingBox, _pointGenInfo, _samplePoints, _cellGenInfo.sampleRadii);
+	}
+
 	return !_samplePoints.empty();
 }
 
-bool Hadan::generateCuttingCells() {
-	std::unique_ptr<ICellGen> gen = CellGenFactory::create(CellGenFactory::Type::Voronoi);
-	gen->generate(_boundingBox, _samplePoints, _cuttingCells);
-	return !_cuttingCells.empty();
+bool Hadan::cullExterior() {
+	MDagPath meshPath = _inputMesh;
+	Model sourceModel;
+	MayaHelper::copyMFnMeshToModel(meshPath, sourceModel);
+
+	// trim cells to planes around the mesh (slightly padded so they never graze its surface) at voronoi time
+	const float padding = _boundingBox.getDiagonalDistance() * 0.001f;
+	PlaneHelper::boundingPlanes(sourceModel, padding, _cellGenInfo.walls);
+
+	// the test built for generating points inside of the mesh is reused if there is one
+	std::shared_ptr<const MeshInsideTest> insideTest = _pointGenInfo.insideMesh;
+	if( nullptr == insideTest ) {
+		std::shared_ptr<MeshInsideTest> builtTest = std::make_shared<MeshInsideTest>();
+		builtTest->build(sourceModel);
+		insideTest = builtTest;
+	}
+
+	// the neighbors of dropped points grow to fill their space, so no part of the mesh goes uncovered
+	// radii (if any) are kept alongside their points
+	const size_t oldCount = _samplePoints.size();
+	std::vector<float>& radii = _cellGenInfo.sampleRadii;
+	const bool hasRadii = (radii.size() == oldCount);
+	size_t keptCount = 0;
+	for( size_t i = 0; i < oldCount; ++i ) {
+		if( !insideTest->contains(_samplePoints[i]) ) {
+			continue;
+		}
+		_samplePoints[keptCount] = _samplePoints[i];
+		if( hasRadii ) {
+			radii[keptCount] = radii[i];
+		}
+		++keptCount;
+	}
+	_samplePoints.resize(keptCount);
+	if( hasRadii ) {
+		radii.resize(keptCount);
+	}
+	MTLog::instance()->log("Culled " + std::to_string(oldCount - _samplePoints.size()) + "/" + std::to_string(oldCount) + " sample points outside of the mesh.\n");
+	return !_samplePoints.empty();
+}
+
+bool Hadan::relaxSamplePoints() {
+	std::unique_ptr<ICellGen> gen = CellGenFactory::create(_cellGenType);
+	return LloydRelaxer(_relaxIterations, relaxPreservesDensity()).relax(*gen, _boundingBox, _cellGenInfo, _samplePoints);
+}
+
+bool Hadan::relaxPreservesDensity() const {
+	// cluster, bezier, and surface points are meant to be denser in places; uniform and poisson points are evened out
+	return (PointGenFactory::Type::Cluster == _pointsGenType) || (PointGenFactory::Type::Bezier == _pointsGenType) || (PointGenFactory::Type::Surface == _pointsGenType);
+}
+
+bool Hadan::savePattern() {
+	// patterns cover the unit cube and wrap around its sides so that they tile
+	_boundingBox = BoundingBox(cc::Vec3f(0.5f, 0.5f, 0.5f), cc::Vec3f(0.5f, 0.5f, 0.5f));
+	if( !generateSamplePoints() ) {
+		return false;
+	}
+	CellGenInfo info = _cellGenInfo;
+	info.periodic = true;
+	info.needsPlanes = true;
+	info.needsFaces = true;
+	info.walls.clear();
+
+	// ids are unique, so each cell can be written straight into its slot from any thread
+	std::vector<Cell> cells(_samplePoints.size());
+	std::unique_ptr<ICellGen> gen = CellGenFactory::create(_cellGenType);
+	if( !gen->generateEach(_boundingBox, _samplePoints, info, [&]( int id, const Cell& cell ) {
+		cells[id] = cell;
+	}) ) {
+		return false;
+	}
+	return CellPattern::save(_savePatternPath, _samplePoints, info.sampleRadii, cells);
+}
+
+std::shared_ptr<IMeshSlicer> Hadan::createSlicer() {
+	std::shared_ptr<IMeshSlicer> slicer = MeshSlicerFactory::create(_slicerType);
+	if( !slicer->setSource(MFnMesh(_inputMesh)) ) {
+		return nullptr;
+	}
+	return slicer;
+}
+
+bool Hadan::generateAndCutCells( std::shared_ptr<IMeshSlicer> slicer ) {
+	// cells are sliced as they are generated rather than collected first, so only as many cells as there are
+	// generation threads are ever held at once.  when multithreaded, the visitor runs on the generator's threads.
+	_cuttingCellCount = 0;
+	_reusedChunkCount = 0;
+	std::unique_ptr<ICellGen> gen = CellGenFactory::create(_cellGenType);
+	const CellSimplifier simplifier(_cellGenInfo);
+
+	// sessions only regenerate the cells around seeds that changed, when the cells can be told apart that way
+	if( _session != nullptr && selectSessionSeeds() ) {
+		std::vector<cc::Vec3f> seedPoints;
+		seedPoints.reserve(_sessionSeedIds.size());
+		for( const int pointId : _sessionSeedIds ) {
+			seedPoints.push_back(_samplePoints[pointId]);
+		}
+		if( !seedPoints.empty() ) {
+			gen->generateEach(_boundingBox, seedPoints, _cellGenInfo, simplifier.wrap([&]( int id, const Cell& cell ) {
+				if( !_sessionRecut[id] ) {
+					return;
+				}
+				++_cuttingCellCount;
+				doSessionCut(cell, id, slicer);
+			}));
+		}
+		_sessionSeedIds.clear();
+		_sessionRecut.clear();
+		return _cuttingCellCount > 0;
+	}
+
+	gen->generateEach(_boundingBox, _samplePoints, _cellGenInfo, simplifier.wrap([&]( int id, const Cell& cell ) {
+		++_cuttingCellCount;
+		if( _session != nullptr ) {
+			doSessionCut(cell, id, slicer);
+		} else {
+			doSingleCut(cell, id, slicer);
+		}
+	}));
+	return _cuttingCellCount > 0;
+}
+
+bool Hadan::generateAndCutCellsRecursively( std::shared_ptr<IMeshSlicer> slicer ) {
+	// the first level is cut from the source mesh as usual, but kept in core rather than created in maya
+	_cuttingCellCount = 0;
+	std::mutex chunksMutex;
+	std::vector<std::pair<int, Model>> idChunks;
+	std::unique_ptr<ICellGen> gen = CellGenFactory::create(_cellGenType);
+	const CellSimplifier simplifier(_cellGenInfo);
+	gen->generateEach(_boundingBox, _samplePoints, _cellGenInfo, simplifier.wrap([&]( int id, const Cell& cell ) {
+		++_cuttingCellCount;
+		Model chunk;
+		if( !slicer->slice(cell, chunk) ) {
+			MTLog::instance()->log("Warning: Failed to slice using cell " + std::to_string(id) + ".  This is sometimes expected.\n");
+			return;
+		}
+		std::lock_guard<std::mutex> lk(chunksMutex);
+		idChunks.push_back(std::make_pair(id, chunk));
+	}));
+
+	// order by cell so that the seeds of deeper levels do not depend on the order that threads finished in
+	std::sort(idChunks.begin(), idChunks.end(), []( const std::pair<int, Model>& lhs, const std::pair<int, Model>& rhs ) {
+		return lhs.first < rhs.first;
+	});
+	std::vector<Model> chunks;
+	chunks.reserve(idChunks.size());
+	for( const auto& entry : idChunks ) {
+		chunks.push_back(entry.second);
+	}
+	idChunks.clear();
+
+	// each level fractures every chunk of the previous one, one task per chunk.  children are kept per chunk so
+	// that the next level is in the same order regardless of the number of threads.
+	for( unsigned int level = 1; level < _depth && !chunks.empty(); ++level ) {
+		std::vector<std::vector<Model>> children(chunks.size());
+		parallelFor(_cellGenInfo.threadCount, static_cast<int>(chunks.size()), [&]( int i ) {
+			fractureChunk(chunks[i], level, static_cast<unsigned int>(i), children[i]);
+		});
+
+		std::vector<Model> nextChunks;
+		for( const auto& list : children ) {
+			nextChunks.insert(nextChunks.end(), list.begin(), list.end());
+		}
+		MTLog::instance()->log("Level " + std::to_string(level+1) + " split " + std::to_string(chunks.size()) + " chunks into " + std::to_string(nextChunks.size()) + ".\n");
+		chunks.swap(nextChunks);
+	}
+
+	createChunkMeshes(chunks);
+	return _cuttingCellCount > 0;
+}
+
+bool Hadan::splitMeshIntoSlabs() {
+	// each plane splits the mesh itself in two, a half-space and its complement, with both halves going down to the next
+	// level.  every slice is of a single plane, and the pieces of a level are split in parallel.
+	struct SlabPiece {
+		Model chunk;
+		std::vector<int> points;
+	};
+	std::vector<SlabPiece> pieces(1);
+	MDagPath meshPath = _inputMesh;
+	MayaHelper::copyMFnMeshToModel(meshPath, pieces.front().chunk);
+	const bool useCutPlanes = !_cellGenInfo.cutPlanes.empty();
+	if( !useCutPlanes ) {
+		for( size_t i = 0; i < _samplePoints.size(); ++i ) {
+			pieces.front().points.push_back(static_cast<int>(i));
+		}
+	}
+
+	// pieces done splitting at medians are kept as they finish, in order of level then piece
+	std::vector<Model> chunks;
+	const size_t levelCount = useCutPlanes ? _cellGenInfo.cutPlanes.size() : std::numeric_limits<size_t>::max();
+	for( size_t level = 0; level < levelCount && !pieces.empty(); ++level ) {
+		std::vector<std::vector<SlabPiece>> children(pieces.size());
+		parallelFor(_cellGenInfo.threadCount, static_cast<int>(pieces.size()), [&]( int i ) {
+			const SlabPiece& piece = pieces[i];
+			std::vector<SlabPiece>& outChildren = children[i];
+			outChildren.resize(2);
+			SlabPiece& positive = outChildren[0];
+			SlabPiece& negative = outChildren[1];
+			Plane plane;
+			if( useCutPlanes ) {
+				plane = _cellGenInfo.cutPlanes[level];
+			} else if( !SlabCellGen::splitPointsAtMedian(_samplePoints, piece.points, plane, positive.points, negative.points) ) {
+				// finished (a lone point, or points that could not be told apart)
+				outChildren.clear();
+				return;
+			}
+
+			// the half-spaces are the piece's padded box on either side of the plane
+			const BoundingBox bbox = piece.chunk.computeBoundingBox();
+			const float padding = bbox.getDiagonalDistance() * 0.01f;
+			const ConvexRegion box = ConvexRegion::box(cc::Vec3f(bbox.minX()-padding, bbox.minY()-padding, bbox.minZ()-padding), cc::Vec3f(bbox.maxX()+padding, bbox.maxY()+padding, bbox.maxZ()+padding));
+			ConvexRegion positiveRegion;
+			ConvexRegion negativeRegion;
+			bool hasPositive = false;
+			bool hasNegative = false;
+			if( box.split(plane, positiveRegion, negativeRegion) ) {
+				std::unique_ptr<IMeshSlicer> slicer = MeshSlicerFactory::create(_slicerType);
+				if( slicer->setSource(piece.chunk) ) {
+					Cell cell;
+					positiveRegion.toCell(_cellGenInfo, cell);
+					hasPositive = slicer->slice(cell, positive.chunk);
+					negativeRegion.toCell(_cellGenInfo, cell);
+					hasNegative = slicer->slice(cell, negative.chunk);
+				}
+			}
+			if( hasPositive && hasNegative ) {
+				return;
+			}
+
+			// the plane missed the piece, so it goes down whole (with the points on its side, which may still split it)
+			const bool onPositive = (hasPositive != hasNegative) ? hasPositive : (plane.signedDistance(bbox.getCenter()) > 0.0f);
+			if( !useCutPlanes && (onPositive ? positive.points : negative.points).empty() ) {
+				outChildren.clear();
+				return;
+			}
+			SlabPiece whole;
+			whole.chunk = piece.chunk;
+			whole.points = onPositive ? positive.points : negative.points;
+			outChildren.clear();
+			outChildren.push_back(std::move(whole));
+		});
+
+		// pieces with no children are finished whole
+		std::vector<SlabPiece> nextPieces;
+		for( size_t i = 0; i < pieces.size(); ++i ) {
+			if( children[i].empty() ) {
+				chunks.push_back(pieces[i].chunk);
+				continue;
+			}
+			for( auto& child : children[i] ) {
+				nextPieces.push_back(std::move(child));
+			}
+		}
+		pieces.swap(nextPieces);
+	}
+	for( const auto& piece : pieces ) {
+		chunks.push_back(piece.chunk);
+	}
+	MTLog::instance()->log("Split the mesh into " + std::to_string(chunks.size()) + " slabs.\n");
+
+	_cuttingCellCount = chunks.size();
+	createChunkMeshes(chunks);
+	return _cuttingCellCount > 0;
+}
+
+void Hadan::createChunkMeshes( std::vector<Model>& chunks ) {
+	// only the final chunks are created in maya
+	for( auto& chunk : chunks ) {
+		MFnMesh outMesh;
+		if( !MayaHelper::copyModelToMFnMesh(chunk, outMesh, static_cast<float>(_meshSlicerInfo.smoothingAngle)) ) {
+			continue;
+		}
+		_generatedMeshes.push_back(outMesh.object());
+	}
+}
+
+void Hadan::fractureChunk( const Model& chunk, unsigned int level, unsigned int chunkIndex, std::vector<Model>& outChunks ) {
+	// chunks are already fractured in parallel, so each one is generated on a single thread.  cutting planes only place the
+	// first level's slabs, so deeper slabs split at the median of the chunk's own points.
+	CellGenInfo cellInfo = _cellGenInfo;
+	cellInfo.threadCount = 1;
+	cellInfo.walls.clear();
+	cellInfo.sampleRadii.clear();
+	cellInfo.cutPlanes.clear();
+	const bool chunkUsesSamplePoints = usesSamplePoints() || (CellGenFactory::Type::Slab == _cellGenType);
+
+	// levels after the first scatter points of the same type in each chunk, seeded per chunk so that results are reproducible.
+	// slabs cut only by planes had no type given, so scatter uniform points.
+	PointGenInfo pointInfo = _pointGenInfo;
+	if( !_levelCounts.empty() ) {
+		pointInfo.uniformCount = _levelCounts[std::min<size_t>(level-1, _levelCounts.size()-1)];
+	}
+	pointInfo.seed = _pointGenInfo.seed + level * 0x9e3779b9u + chunkIndex * 0x85ebca6bu;
+	pointInfo.userPoints.clear();
+	pointInfo.cracks.clear();
+	pointInfo.threadCount = 1;
+	const BoundingBox bbox = chunk.computeBoundingBox();
+	std::shared_ptr<MeshInsideTest> chunkTest = std::make_shared<MeshInsideTest>();
+	chunkTest->build(chunk);
+	pointInfo.insideMesh = _insideMesh ? chunkTest : nullptr;
+	const PointGenFactory::Type pointsGenType = (PointGenFactory::Type::Invalid == _pointsGenType) ? PointGenFactory::Type::Uniform : _pointsGenType;
+	if( PointGenFactory::Type::Surface == pointsGenType ) {
+		// vertex colors belong to the original mesh's vertices, so the chunk's surface is sampled by area alone
+		pointInfo.surfaceModel = std::make_shared<Model>(chunk);
+		pointInfo.surfaceWeights.clear();
+	}
+	std::unique_ptr<IPointGen> pointGen = PointGenFactory::create(pointsGenType);
+	std::vector<cc::Vec3f> points;
+	if( chunkUsesSamplePoints ) {
+		pointGen->generateSamplePoints(bbox, pointInfo, points);
+	}
+	if( CellGenFactory::Type::Power == _cellGenType ) {
+		pointGen->generateSampleRadii(bbox, pointInfo, points, cellInfo.sampleRadii);
+	}
+
+	// points outside of the chunk only make slivers, so they are dropped (keeping radii alongside)
+	const bool hasRadii = !cellInfo.sampleRadii.empty();
+	size_t keptCount = 0;
+	for( size_t i = 0; i < points.size(); ++i ) {
+		if( !chunkTest->contains(points[i]) ) {
+			continue;
+		}
+		points[keptCount] = points[i];
+		if( hasRadii ) {
+			cellInfo.sampleRadii[keptCount] = cellInfo.sampleRadii[i];
+		}
+		++keptCount;
+	}
+	points.resize(keptCount);
+	if( hasRadii ) {
+		cellInfo.sampleRadii.resize(keptCount);
+	}
+
+	// chunks that cannot be fractured any further are kept whole
+	std::unique_ptr<IMeshSlicer> slicer = MeshSlicerFactory::create(_slicerType);
+	const bool hasCells = !chunkUsesSamplePoints || (points.size() > 1);
+	if( hasCells && slicer->setSource(chunk) ) {
+		std::unique_ptr<ICellGen> gen = CellGenFactory::create(_cellGenType);
+		if( _relaxIterations > 0 && chunkUsesSamplePoints ) {
+			LloydRelaxer(_relaxIterations, relaxPreservesDensity()).relax(*gen, bbox, cellInfo, points);
+		}
+		const CellSimplifier simplifier(cellInfo);
+		gen->generateEach(bbox, points, cellInfo, simplifier.wrap([&]( int id, const Cell& cell ) {
+			++_cuttingCellCount;
+			Model piece;
+			if( slicer->slice(cell, piece) ) {
+				outChunks.push_back(piece);
+			}
+		}));
+	}
+	if( outChunks.empty() ) {
+		outChunks.push_back(chunk);
+	}
 }
 
 void Hadan::doSingleCut( const Cell& cell, int id, std::shared_ptr<IMeshSlicer> slicer ) {
 	MFnMesh outMesh;
-	if( !slicer->slice(cell, _meshSlicerInfo, outMesh) ) {
+	if( _useAdjacency ) {
+		// caps are measured from the sliced model before it is created in maya
+		Model outModel;
+		if( !slicer->slice(cell, outModel) ) {
+			MTLog::instance()->log("Warning: Failed to slice using cell " + std::to_string(id) + ".  This is sometimes expected.\n");
+			return;
+		}
+		_adjacency.addChunk(id, cell, outModel);
+		if( !MayaHelper::copyModelToMFnMesh(outModel, outMesh, static_cast<float>(_meshSlicerInfo.smoothingAngle)) ) {
+			return;
+		}
+	} else if( !slicer->slice(cell, _meshSlicerInfo, outMesh) ) {
 		MTLog::instance()->log("Warning: Failed to slice using cell " + std::to_string(id) + ".  This is sometimes expected.\n");
 		return;
 	}
 
 	std::lock_guard<std::mutex> lk(GeneratedMeshesMutex);
 	_generatedMeshes.push_back(outMesh.object());
+	if( _useAdjacency ) {
+		_adjacencyChunks[id] = outMesh.object();
+	}
 }
 
-void Hadan::performCutting() {
-	std::shared_ptr<IMeshSlicer> slicer = MeshSlicerFactory::create(_slicerType);
-	if( !slicer->setSource(MFnMesh(_inputMesh)) ) {
-		MTLog::instance()->log("Warning: Failed to set slicer mesh source.  Cutting will not take place.\n");
+void Hadan::saveAdjacency() {
+	std::map<int, std::string> names;
+	for( const auto& entry : _adjacencyChunks ) {
+		names[entry.first] = MFnDagNode(MFnDagNode(entry.second).parent(0)).name().asChar();
+	}
+	if( !_adjacency.save(_adjacencyPath, names) ) {
+		MTLog::instance()->log("Warning: Failed to write adjacency graph to " + _adjacencyPath + ".\n");
 		return;
 	}
+	MTLog::instance()->log("Wrote " + std::to_string(_adjacency.getContacts().size()) + " chunk contacts to " + _adjacencyPath + ".\n");
+}
 
-	if( _useMultithreading ) {
-		// multi threaded
-		std::vector<std::thread> cuttingThreads;
-		for( size_t i = 0; i < _cuttingCells.size(); ++i ) {
-			cuttingThreads.push_back(std::thread(&Hadan::doSingleCut, this, _cuttingCells[i], i, slicer));
-		}
-		for( auto& t : cuttingThreads ) {
-			t.join();
+void Hadan::doSessionCut( const Cell& cell, int id, std::shared_ptr<IMeshSlicer> slicer ) {
+	// a cell is fully described by its seed and the seeds (or walls) across its faces
+	const HadanSession::SeedKey seed = sessionSeedKey(id);
+	HadanSession::CellRecord record;
+	for( const auto& plane : cell.getPlanes() ) {
+		if( plane.neighborId >= 0 ) {
+			record.neighbors.push_back(sessionSeedKey(plane.neighborId));
+		} else {
+			record.walls.push_back(plane.neighborId);
 		}
+	}
+	std::sort(record.neighbors.begin(), record.neighbors.end());
+	std::sort(record.walls.begin(), record.walls.end());
+	record.corners = cell.getVertices();
+
+	// reuse the previous run's chunk if the cell has not changed; otherwise slice it again
+	const HadanSession::CellRecord* previous = _session->findCell(seed);
+	if( previous != nullptr && previous->sameShapeAs(record) ) {
+		record.chunk = previous->chunk;
+		record.hasChunk = previous->hasChunk;
+		++_reusedChunkCount;
 	} else {
-		// single threaded
-		for( size_t i = 0; i < _cuttingCells.size(); ++i ) {
-			doSingleCut(_cuttingCells[i], i, slicer);
+		MFnMesh outMesh;
+		if( slicer->slice(cell, _meshSlicerInfo, outMesh) ) {
+			record.chunk = outMesh.object();
+			record.hasChunk = true;
+		} else {
+			MTLog::instance()->log("Warning: Failed to slice using cell " + std::to_string(id) + ".  This is sometimes expected.\n");
+		}
+	}
+
+	std::lock_guard<std::mutex> lk(GeneratedMeshesMutex);
+	if( record.hasChunk && (nullptr == previous || !(previous->chunk == record.chunk)) ) {
+		_generatedMeshes.push_back(record.chunk);
+	}
+	_sessionCells[seed] = record;
+}
+
+bool Hadan::selectSessionSeeds() {
+	// a new seed cuts into a voronoi cell only if one of the cell's corners is closer to it than to the cell's seed, and a
+	// removed seed only changes the cells across its faces.  power cells are shifted by their radii, so are all regenerated.
+	_sessionSeedIds.clear();
+	_sessionRecut.clear();
+	if( CellGenFactory::Type::Voronoi != _cellGenType || _session->getCells().empty() ) {
+		return false;
+	}
+
+	// seeds of this run that are new (moved seeds are both new and removed)
+	std::map<HadanSession::SeedKey, int> current;
+	for( size_t i = 0; i < _samplePoints.size(); ++i ) {
+		current[sessionSeedKey(static_cast<int>(i))] = static_cast<int>(i);
+	}
+	std::vector<bool> recut(_samplePoints.size(), false);
+	std::vector<cc::Vec3f> addedSeeds;
+	for( const auto& entry : current ) {
+		if( nullptr == _session->findCell(entry.first) ) {
+			addedSeeds.push_back(_samplePoints[entry.second]);
+			recut[entry.second] = true;
+		}
+	}
+
+	// cells across the faces of removed seeds grow into the space that they leave
+	for( const auto& entry : _session->getCells() ) {
+		if( current.find(entry.first) != current.end() ) {
+			continue;
+		}
+		for( const auto& neighbor : entry.second.neighbors ) {
+			const auto iter = current.find(neighbor);
+			if( iter != current.end() ) {
+				recut[iter->second] = true;
+			}
+		}
+	}
+
+	// kept cells that a new seed cuts into are recut too; the rest keep their previous cell and chunk
+	const float tolerance = _boundingBox.getDiagonalDistance() * 0.0001f;
+	std::vector<bool> isNeeded(_samplePoints.size(), false);
+	for( const auto& entry : current ) {
+		const HadanSession::CellRecord* record = _session->findCell(entry.first);
+		if( nullptr == record ) {
+			continue;
+		}
+		const cc::Vec3f& pos = _samplePoints[entry.second];
+		for( size_t c = 0; c < record->corners.size() && !recut[entry.second]; ++c ) {
+			const float seedDistance = (record->corners[c] - pos).magnitude();
+			for( const auto& added : addedSeeds ) {
+				if( (record->corners[c] - added).magnitude() < seedDistance + tolerance ) {
+					recut[entry.second] = true;
+					break;
+				}
+			}
+		}
+		if( !recut[entry.second] ) {
+			_sessionCells[entry.first] = *record;
+			++_reusedChunkCount;
+			++_cuttingCellCount;
+			continue;
+		}
+
+		// the recut cell's previous neighbors bound it along with any new seeds
+		isNeeded[entry.second] = true;
+		for( const auto& neighbor : record->neighbors ) {
+			const auto iter = current.find(neighbor);
+			if( iter != current.end() ) {
+				isNeeded[iter->second] = true;
+			}
+		}
+	}
+
+	// recut cells are generated from only the seeds that can border them
+	for( size_t i = 0; i < _samplePoints.size(); ++i ) {
+		if( recut[i] || isNeeded[i] ) {
+			_sessionSeedIds.push_back(static_cast<int>(i));
+			_sessionRecut.push_back(recut[i]);
+		}
+	}
+	MTLog::instance()->log("Session regenerating " + std::to_string(std::count(recut.begin(), recut.end(), true)) + "/" + std::to_string(_samplePoints.size()) + " cells from " + std::to_string(_sessionSeedIds.size()) + " seeds.\n");
+	return true;
+}
+
+HadanSession::SeedKey Hadan::sessionSeedKey( int id ) const {
+	// ids are of the generated cells, which are only some of the sample points when part of the diagram is regenerated
+	const int pointId = _sessionSeedIds.empty() ? id : _sessionSeedIds[id];
+	const cc::Vec3f& pos = _samplePoints[pointId];
+	const float radius = _cellGenInfo.sampleRadii.empty() ? 0.0f : _cellGenInfo.sampleRadii[pointId];
+	return HadanSession::SeedKey(pos.x, pos.y, pos.z, radius);
+}
+
+std::string Hadan::sessionFingerprint() const {
+	// everything other than the sample points that changes what cells are cut or how
+	const cc::Vec3f& center = _boundingBox.getCenter();
+	const cc::Vec3f& halfExtents = _boundingBox.getHalfExtents();
+	std::string fingerprint;
+	fingerprint += std::to_string(static_cast<int>(_slicerType)) + " " + std::to_string(static_cast<int>(_cellGenType));
+	fingerprint += " " + std::to_string(_meshSlicerInfo.smoothingAngle) + " " + std::to_string(_cullExterior) + " " + std::to_string(_insideMesh);
+	fingerprint += " " + std::to_string(_cellGenInfo.minFaceAreaPercent) + " " + std::to_string(_cellGenInfo.mergeAngle);
+	fingerprint += " " + std::to_string(center.x) + " " + std::to_string(center.y) + " " + std::to_string(center.z);
+	fingerprint += " " + std::to_string(halfExtents.x) + " " + std::to_string(halfExtents.y) + " " + std::to_string(halfExtents.z);
+	fingerprint += " " + std::to_string(MFnMesh(_inputMesh).numVertices());
+
+	// the mesh's vertices are hashed (fnv-1a) so that moving any of them, even within the bounding box, starts over
+	MPointArray points;
+	MFnMesh(_inputMesh).getPoints(points, MSpace::kWorld);
+	unsigned long long pointsHash = 14695981039346656037ull;
+	for( unsigned int i = 0; i < points.length(); ++i ) {
+		const float coords[3] = {static_cast<float>(points[i].x), static_cast<float>(points[i].y), static_cast<float>(points[i].z)};
+		const unsigned char* bytes = reinterpret_cast<const unsigned char*>(coords);
+		for( size_t b = 0; b < sizeof(coords); ++b ) {
+			pointsHash = (pointsHash ^ bytes[b]) * 1099511628211ull;
 		}
 	}
+	fingerprint += " " + std::to_string(pointsHash);
+	return fingerprint;
 }
 
 void Hadan::centerAllPivots() {
@@ -1,5 +1,6 @@
 #include "BezierPath.hpp"
 #include <stack>
+#include <algorithm>
 
 BezierPath::BezierPath() {
 }
@@ -88,7 +89,13 @@ void BezierPath::samplePoints( const std::vector<cc::Vec3f>& sourcePoints, float
 	interpolate(samplePointsVec, scale);
 }
 
-cc::Vec3f BezierPath::calculateBezierPoint( int curveIndex, float t ) {
+// steps of the arc length table per sample, and the fewest and most steps per curve.  forward differencing gathers
+// rounding error with each step, which stays well below a sample's spacing up to the cap.
+static const unsigned int ARC_STEPS_PER_SAMPLE = 4;
+static const unsigned int MIN_ARC_STEPS = 64;
+static const unsigned int MAX_ARC_STEPS = 4096;
+
+cc::Vec3f BezierPath::calculateBezierPoint( int curveIndex, float t ) const {
 	const int nodeIndex = curveIndex * 3;
 	const cc::Vec3f& p0 = _controlPoints[nodeIndex];
 	const cc::Vec3f& p1 = _controlPoints[nodeIndex+1];
@@ -97,54 +104,41 @@ cc::Vec3f BezierPath::calculateBezierPoint( int curveIndex, float t ) {
 	return calculateBezierPoint(t, p0, p1, p2, p3);
 }
 
-std::vector<cc::Vec3f> BezierPath::getDrawingPoints( unsigned int samples ) {
+std::vector<cc::Vec3f> BezierPath::getEvenlySpacedPoints( unsigned int samples ) const {
 	std::vector<cc::Vec3f> drawingPoints;
-	for( unsigned int curveIndex = 0; curveIndex < _curveCount; ++curveIndex ) {
-		// only do this for the first endpoint.  when i!=0 this coincides with the endpoint of the previous segment
-		if( 0 == curveIndex ) {
-			drawingPoints.push_back(calculateBezierPoint(curveIndex, 0));
-		}
-
-		for( unsigned int j = 1; j <= samples; ++j ) {
-			const float t = static_cast<float>(j) / static_cast<float>(samples);
-			drawingPoints.push_back(calculateBezierPoint(curveIndex, t));
-		}
+	if( 0 == _curveCount || 0 == samples ) {
+		return drawingPoints;
 	}
-	return drawingPoints;
-}
+	drawingPoints.reserve(1 + _curveCount * samples);
+	drawingPoints.push_back(_controlPoints[0]);
 
-std::vector<cc::Vec3f> BezierPath::getDrawingPointsAlternate( unsigned int samples ) {
-	std::vector<cc::Vec3f> drawingPoints;
-	for( unsigned int i = 0; i < _controlPoints.size()-3; i += 3 ) {
-		const cc::Vec3f& p0 = _controlPoints[0];
-		const cc::Vec3f& p1 = _controlPoints[0+1];
-		const cc::Vec3f& p2 = _controlPoints[0+2];
-		const cc::Vec3f& p3 = _controlPoints[0+3];
-		if( 0 == i ) {
-			drawingPoints.push_back(calculateBezierPoint(0, p0, p1, p2, p3));
-		}
-		for( unsigned int j = 1; j <= samples; ++j ) {
-			const float t = static_cast<float>(j) / static_cast<float>(samples);
-			drawingPoints.push_back(calculateBezierPoint(t, p0, p1, p2, p3));
-		}
-	}
-	return drawingPoints;
-}
-
-std::vector<cc::Vec3f> BezierPath::getDrawingPointsRecursive( unsigned int samples ) {
-	std::vector<cc::Vec3f> drawingPoints;
+	const unsigned int steps = std::min<unsigned int>(MAX_ARC_STEPS, std::max<unsigned int>(MIN_ARC_STEPS, samples * ARC_STEPS_PER_SAMPLE));
+	std::vector<float> lengths;
 	for( unsigned int curveIndex = 0; curveIndex < _curveCount; ++curveIndex ) {
-		std::vector<cc::Vec3f> bezierCurveDrawingPoints = findDrawingPoints(curveIndex);
-		if( curveIndex != 0 ) {
-			// remove first point, as it coincides with the lsat point of the previous bezier curve
-			bezierCurveDrawingPoints.erase(bezierCurveDrawingPoints.begin() + 0);
+		buildArcLengthTable(curveIndex, steps, lengths);
+		const float totalLength = lengths[steps];
+
+		// targets only increase, so the table is walked once per curve rather than searched per sample
+		unsigned int step = 0;
+		for( unsigned int j = 1; j <= samples; ++j ) {
+			float t = static_cast<float>(j) / static_cast<float>(samples);
+			if( j < samples && totalLength > 0.0f ) {
+				const float target = totalLength * t;
+				while( step + 1 < steps && lengths[step+1] < target ) {
+					++step;
+				}
+				// t is close to linear in distance within a step
+				const float stepLength = lengths[step+1] - lengths[step];
+				const float fraction = (stepLength > 0.0f) ? cc::math::clamp<float>((target - lengths[step]) / stepLength, 0.0f, 1.0f) : 0.0f;
+				t = (static_cast<float>(step) + fraction) / static_cast<float>(steps);
+			}
+			drawingPoints.push_back(calculateBezierPoint(static_cast<int>(curveIndex), t));
 		}
-		drawingPoints.insert(std::end(drawingPoints), std::begin(bezierCurveDrawingPoints), std::end(bezierCurveDrawingPoints));
 	}
 	return drawingPoints;
 }
 
-cc::Vec3f BezierPath::calculateBezierPoint( float t, const cc::Vec3f& p0, const cc::Vec3f& p1, const cc::Vec3f& p2, const cc::Vec3f& p3 ) {
+cc::Vec3f BezierPath::calculateBezierPoint( float t, const cc::Vec3f& p0, const cc::Vec3f& p1, const cc::Vec3f& p2, const cc::Vec3f& p3 ) const {
 	const float u = 1.0f - t;
 	const float tt = t * t;
 	const float uu = u * u;
@@ -158,38 +152,28 @@ cc::Vec3f BezierPath::calculateBezierPoint( float t, const cc::Vec3f& p0, const
 	return p;
 }
 
-std::vector<cc::Vec3f> BezierPath::findDrawingPoints( unsigned int curveIndex ) {
-	std::vector<cc::Vec3f> pointList;
-	const cc::Vec3f left = calculateBezierPoint(curveIndex, 0);
-	const cc::Vec3f right = calculateBezierPoint(curveIndex, 1);
-	pointList.push_back(left);
-	pointList.push_back(right);
-	findDrawingPoints(curveIndex, 0, 1, pointList, 1);
-	return pointList;
-}
-
-int BezierPath::findDrawingPoints( unsigned int curveIndex, float t0, float t1, std::vector<cc::Vec3f>& pointList, unsigned int insertionIndex ) {
-	const float MIN_SQR_DIST = 0.01f;
-	const float DIV_THRESHOLD = -0.99f; // 172 degrees, 8 degrees from straight line
-	const cc::Vec3f left = calculateBezierPoint(curveIndex, t0);
-	const cc::Vec3f right = calculateBezierPoint(curveIndex, t1);
-	if( (left - right).sqrMagnitude() < MIN_SQR_DIST ) {
-		return 0;
-	}
-
-	const float tMid = (t0 + t1) / 2.0f;
-	const cc::Vec3f mid = calculateBezierPoint(curveIndex, tMid);
-
-	const cc::Vec3f leftDirection = (left - mid).normalized();
-	const cc::Vec3f rightDirection = (right - mid).normalized();
-
-	if( leftDirection.dot(rightDirection) > DIV_THRESHOLD || fabsf(tMid - 0.5f) < 0.0001f ) {
-		int pointsAddedCount = 0;
-		pointsAddedCount += findDrawingPoints(curveIndex, t0, tMid, pointList, insertionIndex);
-		pointList.insert(std::begin(pointList) + (insertionIndex + pointsAddedCount), mid);
-		pointsAddedCount++;
-		pointsAddedCount += findDrawingPoints(curveIndex, tMid, t1, pointList, insertionIndex + pointsAddedCount);
-		return pointsAddedCount;
+void BezierPath::buildArcLengthTable( unsigned int curveIndex, unsigned int steps, std::vector<float>& outLengths ) const {
+	// as a polynomial a*t^3 + b*t^2 + c*t + d, whose third difference is constant, so each step is three additions
+	const unsigned int nodeIndex = curveIndex * 3;
+	const cc::Vec3f& p0 = _controlPoints[nodeIndex];
+	const cc::Vec3f& p1 = _controlPoints[nodeIndex+1];
+	const cc::Vec3f& p2 = _controlPoints[nodeIndex+2];
+	const cc::Vec3f& p3 = _controlPoints[nodeIndex+3];
+	const cc::Vec3f a = p3 - 3.0f * p2 + 3.0f * p1 - p0;
+	const cc::Vec3f b = 3.0f * (p2 - 2.0f * p1 + p0);
+	const cc::Vec3f c = 3.0f * (p1 - p0);
+	const float h = 1.0f / static_cast<float>(steps);
+	const float hh = h * h;
+	const float hhh = hh * h;
+	cc::Vec3f delta1 = a * hhh + b * hh + c * h;
+	cc::Vec3f delta2 = 6.0f * a * hhh + 2.0f * b * hh;
+	const cc::Vec3f delta3 = 6.0f * a * hhh;
+
+	outLengths.resize(steps + 1);
+	outLengths[0] = 0.0f;
+	for( unsigned int i = 1; i <= steps; ++i ) {
+		outLengths[i] = outLengths[i-1] + delta1.magnitude();
+		delta1 += delta2;
+		delta2 += delta3;
 	}
-	return 0;
 }
\ No newline at end of file
@@ -14,15 +14,14 @@ public:
 	const std::vector<cc::Vec3f> getControlPoints() const;
 	void interpolate( const std::vector<cc::Vec3f>& segmentPoints, float scale );
 	void samplePoints( const std::vector<cc::Vec3f>& sourcePoints, float minSqrDist, float maxSqrDist, float scale );
-	cc::Vec3f calculateBezierPoint( int curveIndex, float t );
-	std::vector<cc::Vec3f> getDrawingPoints( unsigned int samples );
-	std::vector<cc::Vec3f> getDrawingPointsAlternate( unsigned int samples );
-	std::vector<cc::Vec3f> getDrawingPointsRecursive( unsigned int samples );
+	cc::Vec3f calculateBezierPoint( int curveIndex, float t ) const;
+	// samples points per curve spaced evenly by distance along it rather than evenly in t, starting with the start of the path
+	std::vector<cc::Vec3f> getEvenlySpacedPoints( unsigned int samples ) const;
 
 private:
-	cc::Vec3f calculateBezierPoint( float t, const cc::Vec3f& p0, const cc::Vec3f& p1, const cc::Vec3f& p2, const cc::Vec3f& p3 );
-	std::vector<cc::Vec3f> findDrawingPoints( unsigned int curveIndex );
-	int findDrawingPoints( unsigned int curveIndex, float t0, float t1, std::vector<cc::Vec3f>& pointList, unsigned int insertionIndex );
+	cc::Vec3f calculateBezierPoint( float t, const cc::Vec3f& p0, const cc::Vec3f& p1, const cc::Vec3f& p2, const cc::Vec3f& p3 ) const;
+	// distance along a curve at steps+1 evenly spaced values of t
+	void buildArcLengthTable( unsigned int curveIndex, unsigned int steps, std::vector<float>& outLengths ) const;
 
 private:
 	std::vector<cc::Vec3f> _controlPoints;
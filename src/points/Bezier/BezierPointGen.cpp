@@ -2,6 +2,7 @@
 #include "BezierPath.hpp"
 #include "../../MTLog.hpp"
 #include <Random.hpp>
+#include <algorithm>
 
 BezierPointGen::BezierPointGen()
 	: IPointGen() {
@@ -11,47 +12,106 @@ BezierPointGen::~BezierPointGen() {
 }
 
 void BezierPointGen::generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) {
-	MTLog::instance()->log("Generating bezier:\n");
+	// without any cracks given, the user's points make a single crack
+	std::vector<PointGenInfo::CrackInfo> cracks = info.cracks;
+	if( cracks.empty() ) {
+		PointGenInfo::CrackInfo crack;
+		crack.controlPoints = info.userPoints;
+		crack.samples = info.samples;
+		crack.flux = info.flux;
+		cracks.push_back(crack);
+	}
+
+	// control points are few and logged, so are made in order, each crack drawing from its own index
+	std::vector<std::vector<cc::Vec3f>> paths(cracks.size());
+	for( size_t i = 0; i < cracks.size(); ++i ) {
+		MTLog::instance()->log("Generating bezier" + (cracks.size() > 1 ? " " + std::to_string(i) : std::string()) + ":\n");
+		if( 0 == cracks[i].samples ) {
+			MTLog::instance()->log("Warning: Curve will be ignored as Samples were zero.\n");
+			continue;
+		}
+		Random<float, int> rnd(info.seed, STREAM_SHAPE, static_cast<unsigned int>(i));
+		buildControlPoints(boundingBox, cracks[i].controlPoints, info.minBezierDistance, rnd, paths[i]);
+	}
+
+	// extract points along every bezier path at once, each into its own list
+	std::vector<std::vector<cc::Vec3f>> curvePoints(cracks.size());
+	parallelFor(info.threadCount, static_cast<int>(cracks.size()), [&]( int i ) {
+		if( paths[i].empty() ) {
+			return;
+		}
+		BezierPath bezier;
+		bezier.setControlPoints(paths[i]);
+		curvePoints[i] = bezier.getEvenlySpacedPoints(cracks[i].samples);
+	});
 
-	if( 0 == info.samples ) {
-		MTLog::instance()->log("Warning: Curve will be ignored as Samples were zero.  Fracturing will not occur.\n");
+	// the points of all cracks are laid out one crack after another, and draw from consecutive indices in that order
+	std::vector<unsigned int> crackStarts(cracks.size() + 1, 0);
+	for( size_t i = 0; i < cracks.size(); ++i ) {
+		crackStarts[i+1] = crackStarts[i] + static_cast<unsigned int>(curvePoints[i].size());
+	}
+	const unsigned int curvePointCount = crackStarts.back();
+	if( 0 == curvePointCount ) {
+		MTLog::instance()->log("Warning: No curves were sampled.  Fracturing will not occur.\n");
 		return;
 	}
+	const size_t firstPoint = outPoints.size();
+	outPoints.resize(firstPoint + curvePointCount);
+
+	// fluctuate points from curve to break how uniform they appear.  parts of the curve outside of the mesh are replaced
+	// with points inside of it, so that the number of points holds unless the mesh is too thin for them to be placed.
+	std::vector<char> placed(curvePointCount, 1);
+	const cc::Vec3f cornerDiff = boundingBox.getCorner(BoundingBox::Corner::BottomLeftBack) - boundingBox.getCorner(BoundingBox::Corner::TopRightFront);
+	forEachPoint(info, curvePointCount, [&]( unsigned int i ) {
+		const size_t crack = static_cast<size_t>(std::upper_bound(crackStarts.begin(), crackStarts.end(), i) - crackStarts.begin()) - 1;
+		Random<float, int> pointRnd(info.seed, STREAM_FLUX, i);
+		cc::Vec3f pnt = curvePoints[crack][i - crackStarts[crack]];
+		if( !cc::math::equal<double>(cracks[crack].flux, 0.0) ) {
+			const float fluxAmount = cc::math::percent<float>(cornerDiff.magnitude(), static_cast<float>(cracks[crack].flux));
+			placed[i] = fluxPoint(pointRnd, pnt, fluxAmount, boundingBox, info, pnt);
+		}
+		if( placed[i] && info.insideMesh != nullptr && !info.insideMesh->contains(pnt) ) {
+			placed[i] = randomPoint(pointRnd, boundingBox, info, pnt);
+		}
+		outPoints[firstPoint + i] = pnt;
+	});
+	dropUnplacedPoints(outPoints, firstPoint, placed);
 
-	// create seeded random
-	Random<float, int> rnd(info.seed);
+	// add some uniformly random points to add some extra detail away from the curve
+	randomPoints(boundingBox, info, STREAM_UNIFORM, info.uniformCount, outPoints);
 
-	// set control points to user-provided points
-	std::vector<cc::Vec3f> controlPoints = info.userPoints;
+	fflush(stdout);
+}
 
-	std::vector<cc::Vec3f> bezierPoints;
-	if( 4 == controlPoints.size() ) { // all control points are provided
+void BezierPointGen::buildControlPoints( const BoundingBox& boundingBox, const std::vector<cc::Vec3f>& userPoints, double minBezierDistance, Random<float, int>& rnd, std::vector<cc::Vec3f>& outControlPoints ) const {
+	outControlPoints.clear();
+	if( userPoints.size() >= 4 && 1 == (userPoints.size() % 3) ) { // all control points are provided, for one or more joined curves
 		MTLog::instance()->log("\tall points provided; building curve from points\n");
-		bezierPoints = controlPoints;
-	} else if( 2 == controlPoints.size() ) { // start and end points are provided; generate random midpoints
+		outControlPoints = userPoints;
+	} else if( 2 == userPoints.size() ) { // start and end points are provided; generate random midpoints
 		MTLog::instance()->log("\tstart and end points provided; generating intermediate points\n");
-		bezierPoints.push_back(controlPoints[0]);
-		bezierPoints.push_back(rnd.pointInBBox(boundingBox));
-		bezierPoints.push_back(rnd.pointInBBox(boundingBox));
-		bezierPoints.push_back(controlPoints[1]);
+		outControlPoints.push_back(userPoints[0]);
+		outControlPoints.push_back(rnd.pointInBBox(boundingBox));
+		outControlPoints.push_back(rnd.pointInBBox(boundingBox));
+		outControlPoints.push_back(userPoints[1]);
 	} else { // no control points provided (or too many); randomly generate all (p0 and p3 on faces, p1 and p2 randomly inside)
 		MTLog::instance()->log("\tno points provided; generating all points\n");
 		// get distance from one corner of the bbox to the other
 		const cc::Vec3f cornerDiff = boundingBox.getCorner(BoundingBox::Corner::BottomLeftBack) - boundingBox.getCorner(BoundingBox::Corner::TopRightFront);
-		const float minDistance = cc::math::percent<float>(cornerDiff.magnitude(), static_cast<float>(info.minBezierDistance));
+		const float minDistance = cc::math::percent<float>(cornerDiff.magnitude(), static_cast<float>(minBezierDistance));
 		MTLog::instance()->log("\tsize: " + std::to_string(cornerDiff.magnitude()) + "; minDistance: " + std::to_string(minDistance) + "\n");
 
 		// first point (on surface of bounding box)
 		int p0Side = -1;
 		const cc::Vec3f p0 = rnd.pointOnBbox(boundingBox, p0Side, -1);
-		bezierPoints.push_back(p0);
+		outControlPoints.push_back(p0);
 		MTLog::instance()->log("\tp0: face " + std::to_string(p0Side) + " at (" + std::to_string(p0.x) + ", " + std::to_string(p0.y) + ", " + std::to_string(p0.z) + ")\n");
 
 		// second and third are randomly generated
-		bezierPoints.push_back(rnd.pointInBBox(boundingBox));
-		MTLog::instance()->log("\tp1: (" + std::to_string(bezierPoints.back().x) + ", " + std::to_string(bezierPoints.back().y) + ", " + std::to_string(bezierPoints.back().z) + ")\n");
-		bezierPoints.push_back(rnd.pointInBBox(boundingBox));
-		MTLog::instance()->log("\tp2: (" + std::to_string(bezierPoints.back().x) + ", " + std::to_string(bezierPoints.back().y) + ", " + std::to_string(bezierPoints.back().z) + ")\n");
+		outControlPoints.push_back(rnd.pointInBBox(boundingBox));
+		MTLog::instance()->log("\tp1: (" + std::to_string(outControlPoints.back().x) + ", " + std::to_string(outControlPoints.back().y) + ", " + std::to_string(outControlPoints.back().z) + ")\n");
+		outControlPoints.push_back(rnd.pointInBBox(boundingBox));
+		MTLog::instance()->log("\tp2: (" + std::to_string(outControlPoints.back().x) + ", " + std::to_string(outControlPoints.back().y) + ", " + std::to_string(outControlPoints.back().z) + ")\n");
 
 		// fourth is on another side and must be a certain percentage of the size of the bounding box away from the first point
 		const unsigned int MAX_ITERATIONS = 10;
@@ -67,31 +127,7 @@ void BezierPointGen::generateSamplePoints( const BoundingBox& boundingBox, const
 			}
 			
 		} while(p3.distance(p0) < minDistance);
-		bezierPoints.push_back(p3);
+		outControlPoints.push_back(p3);
 		MTLog::instance()->log("\tp3: face " + std::to_string(p3Side) + " at (" + std::to_string(p3.x) + ", " + std::to_string(p3.y) + ", " + std::to_string(p3.z) + "\n");
 	}
-
-	// extract points along bezier curve
-	BezierPath bezier;
-	bezier.setControlPoints(bezierPoints);
-	//for( auto& pnt : bezier.getDrawingPoints(info.samples) ) {
-	for( auto& pnt : bezier.getDrawingPointsAlternate(info.samples) ) {
-		outPoints.push_back(pnt);
-	}
-
-	// fluctuate points from curve to break how uniform they appear
-	if( !cc::math::equal<double>(info.flux, 0.0) ) {
-		const cc::Vec3f cornerDiff = boundingBox.getCorner(BoundingBox::Corner::BottomLeftBack) - boundingBox.getCorner(BoundingBox::Corner::TopRightFront);
-		const float fluxAmount = cc::math::percent<float>(cornerDiff.magnitude(), static_cast<float>(info.flux));
-		for( auto& pnt : outPoints ) {
-			pnt += cc::Vec3f(rnd.nextReal(-fluxAmount, fluxAmount), rnd.nextReal(-fluxAmount, fluxAmount), rnd.nextReal(-fluxAmount, fluxAmount));
-		}
-	}
-
-	// add some uniformly random points to add some extra detail away from the curve
-	for( unsigned int i = 0; i < info.uniformCount; ++i ) {
-		outPoints.push_back(rnd.pointInBBox(boundingBox));
-	}
-
-	fflush(stdout);
 }
\ No newline at end of file
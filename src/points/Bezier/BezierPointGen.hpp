@@ -9,6 +9,17 @@ public:
 	~BezierPointGen();
 
 	virtual void generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) override;
+
+private:
+	/**
+	 * Builds the control points of a crack's path from the points given for it, generating any that are missing.
+	 * @param[in]  boundingBox       Input geometry's bounding box.
+	 * @param[in]  userPoints        Points given for the crack.  Any 3n+1 make a path; two are its ends; otherwise it is random.
+	 * @param[in]  minBezierDistance Distance between random ends as a percentage of the bounding box's size.
+	 * @param[in]  rnd               Random generator to draw from.
+	 * @param[out] outControlPoints  Control points of the path.
+	 */
+	void buildControlPoints( const BoundingBox& boundingBox, const std::vector<cc::Vec3f>& userPoints, double minBezierDistance, Random<float, int>& rnd, std::vector<cc::Vec3f>& outControlPoints ) const;
 };
 
 #endif /* __bezier_point_gen__ */
\ No newline at end of file
@@ -1,49 +1,87 @@
 #include "ClusterPointGen.hpp"
 #include <Random.hpp>
 #include "../../MTLog.hpp"
-#include "../../Random.hpp"
+#include <algorithm>
 
 ClusterPointGen::ClusterPointGen()
-	: IPointGen() {
+	: IPointGen(), _clusteredStart(0), _clusteredEnd(0) {
 }
 
 ClusterPointGen::~ClusterPointGen() {
 }
 
 void ClusterPointGen::generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) {
+	_clusteredStart = _clusteredEnd = outPoints.size();
+	_primaryIndices.clear();
 	if( cc::math::equal<double>(info.flux, 0.0) ) {
 		MTLog::instance()->log("Warning: Fluctuation percentate for cluster fracture must be nonzero.  Fracturing will not occur.\n");
 		return;
 	}
 
-	// seeded random
-	Random<float, int> rnd(info.seed);
-
 	// initialize to user-provided points
 	std::vector<cc::Vec3f> primaryPoints = info.userPoints;
 	
 	// randomly generate some extra points in addition to user-provided ones
-	for( unsigned int i = 0; i < info.primaryCount; ++i ) {
-		primaryPoints.push_back(rnd.pointInBBox(boundingBox));
-	}
+	randomPoints(boundingBox, info, STREAM_PRIMARY, info.primaryCount, primaryPoints);
 
-	// push back primary points and generate and add all secondary points
+	// push back primary points and generate and add all secondary points.  each primary's secondaries are drawn from
+	// their own indices, and each cluster is written to its own slot, so clusters can be generated on any thread.
+	// secondaries are normally distributed around their primary, as spread out as points filling the flux box would be.
 	const float fluxAmount = cc::math::percent<float>(static_cast<float>(boundingBox.getDiagonalDistance()), static_cast<float>(info.flux));
-	for( size_t i = 0; i < primaryPoints.size(); ++i ) {
+	const float deviation = fluxAmount * 0.57735027f;
+	const size_t clusterSize = info.secondaryCount + 1;
+	const size_t firstPoint = outPoints.size();
+	outPoints.resize(firstPoint + primaryPoints.size() * clusterSize);
+	std::vector<char> placed(primaryPoints.size() * clusterSize, 1);
+	forEachPoint(info, static_cast<unsigned int>(primaryPoints.size()), [&]( unsigned int i ) {
 		const cc::Vec3f& curr = primaryPoints[i];
-		outPoints.push_back(curr);
+		cc::Vec3f* cluster = &outPoints[firstPoint + i * clusterSize];
+		cluster[0] = curr;
+
+		// flux cannot be zero or cells can fail to generate
+		gaussianPoints(info, STREAM_SECONDARY, i * info.secondaryCount, info.secondaryCount, curr, deviation, cluster + 1);
+		if( nullptr == info.insideMesh ) {
+			return;
+		}
 
+		// secondaries outside of the mesh are replaced by offsets of their primary that are inside of it
+		Random<float, int> rnd(info.seed, STREAM_FLUX, i);
 		for( unsigned int j = 0; j < info.secondaryCount; ++j ) {
-			cc::Vec3f second = curr;
-			second.x += static_cast<float>(rnd.nextReal(-fluxAmount, fluxAmount)); // cannot be zero or cells can fail to generate
-			second.y += static_cast<float>(rnd.nextReal(-fluxAmount, fluxAmount));
-			second.z += static_cast<float>(rnd.nextReal(-fluxAmount, fluxAmount));
-			outPoints.push_back(second);
+			if( !info.insideMesh->contains(cluster[j+1]) ) {
+				placed[i * clusterSize + j + 1] = fluxPoint(rnd, curr, fluxAmount, boundingBox, info, cluster[j+1]);
+			}
+		}
+	});
+
+	// find where each primary ends up once the secondaries that could not be placed are dropped
+	size_t placedCount = 0;
+	for( size_t i = 0; i < placed.size(); ++i ) {
+		if( 0 == (i % clusterSize) ) {
+			_primaryIndices.push_back(firstPoint + placedCount);
 		}
+		placedCount += placed[i] ? 1 : 0;
 	}
+	_clusteredEnd = firstPoint + placedCount;
+	dropUnplacedPoints(outPoints, firstPoint, placed);
 
 	// generate tertiary uniform points to even out the effect
-	for( unsigned int i = 0; i < info.uniformCount; ++i ) {
-		outPoints.push_back(rnd.pointInBBox(boundingBox));
+	randomPoints(boundingBox, info, STREAM_UNIFORM, info.uniformCount, outPoints);
+}
+
+void ClusterPointGen::generateSampleRadii( const BoundingBox& boundingBox, const PointGenInfo& info, const std::vector<cc::Vec3f>& points, std::vector<float>& outRadii ) {
+	// start with random radii, which the tertiary uniform points keep
+	IPointGen::generateSampleRadii(boundingBox, info, points, outRadii);
+
+	// points are laid out as each primary point followed by its secondary points, so primaries get the largest radius and
+	// secondaries none, giving large chunks ringed by small shards
+	const float maxRadius = cc::math::percent<float>(boundingBox.getDiagonalDistance(), static_cast<float>(info.radiusPercent));
+	const size_t clusteredEnd = std::min<size_t>(points.size(), _clusteredEnd);
+	for( size_t i = _clusteredStart; i < clusteredEnd; ++i ) {
+		outRadii[i] = 0.0f;
+	}
+	for( const size_t index : _primaryIndices ) {
+		if( index < clusteredEnd ) {
+			outRadii[index] = maxRadius;
+		}
 	}
 }
\ No newline at end of file
@@ -9,6 +9,12 @@ public:
 	~ClusterPointGen();
 
 	virtual void generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) override;
+	virtual void generateSampleRadii( const BoundingBox& boundingBox, const PointGenInfo& info, const std::vector<cc::Vec3f>& points, std::vector<float>& outRadii ) override;
+
+private:
+	size_t _clusteredStart; // index of the first point of the clusters last generated
+	size_t _clusteredEnd; // index after the last point of the clusters last generated
+	std::vector<size_t> _primaryIndices; // index of each primary point, as secondaries that could not be placed shift them
 };
 
 #endif /* __cluster_point_gen__ */
\ No newline at end of file
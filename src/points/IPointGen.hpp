@@ -5,6 +5,9 @@
 #include <cc/Vec3.hpp>
 #include "../BoundingBox.hpp"
 #include "PointGenInfo.hpp"
+#include "../Random.hpp"
+#include "../ParallelFor.hpp"
+#include "../MTLog.hpp"
 
 class IPointGen {
 public:
@@ -20,6 +23,250 @@ public:
 	 * @param[out] outPoints   Output vector of generated points.
 	 */
 	virtual void generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints )=0;
+
+	/**
+	 * Generates a radius for each sample point, used to weight cells in a power diagram.  By default, radii are random.
+	 * @param[in]  boundingBox Input geometry's bounding box.
+	 * @param[in]  info        Information to assist generation.
+	 * @param[in]  points      Sample points previously output by generateSamplePoints.
+	 * @param[out] outRadii    Output vector of one radius per sample point.
+	 */
+	virtual void generateSampleRadii( const BoundingBox& boundingBox, const PointGenInfo& info, const std::vector<cc::Vec3f>& points, std::vector<float>& outRadii ) {
+		const float maxRadius = cc::math::percent<float>(boundingBox.getDiagonalDistance(), static_cast<float>(info.radiusPercent));
+		// radii have their own stream so that they are not correlated with the positions drawn from the same seed
+		outRadii.clear();
+		for( size_t i = 0; i < points.size(); ++i ) {
+			outRadii.push_back(Random<float, int>(info.seed, STREAM_RADIUS, static_cast<unsigned int>(i)).nextReal(0.0f, maxRadius));
+		}
+	}
+
+protected:
+	// streams of random draws.  each point draws from its own index of a stream rather than after the previous point,
+	// so points can be generated in any order and on any number of threads and still come out the same.
+	enum Stream {
+		STREAM_SHAPE = 0, // draws shaping the whole set, such as bezier control points, made in order
+		STREAM_PRIMARY,
+		STREAM_SECONDARY,
+		STREAM_UNIFORM,
+		STREAM_FLUX,
+		STREAM_RADIUS,
+		STREAM_SURFACE,
+		STREAM_BARYCENTRIC
+	};
+
+	// largest number of points generated together
+	static const unsigned int POINTS_PER_BLOCK = 1024;
+
+	// points generated together as separate x, y, and z arrays, so that each array is filled with vector instructions
+	struct PointBlock {
+		float x[POINTS_PER_BLOCK];
+		float y[POINTS_PER_BLOCK];
+		float z[POINTS_PER_BLOCK];
+		unsigned int count;
+
+		void copyTo( cc::Vec3f* outPoints ) const {
+			for( unsigned int i = 0; i < count; ++i ) {
+				outPoints[i] = cc::Vec3f(x[i], y[i], z[i]);
+			}
+		}
+	};
+
+	/**
+	 * Runs task(first, count) for blocks of point indices covering [0, count), spread over info's threads.
+	 * @param[in] info  Information to assist generation.
+	 * @param[in] count Number of points.
+	 * @param[in] task  Task to run for each block, called concurrently when more than one thread is used.
+	 */
+	template<typename Task>
+	static void forEachBlock( const PointGenInfo& info, unsigned int count, const Task& task ) {
+		const int blockCount = static_cast<int>((count + POINTS_PER_BLOCK - 1) / POINTS_PER_BLOCK);
+		parallelFor(info.threadCount, blockCount, [&]( int block ) {
+			const unsigned int first = static_cast<unsigned int>(block) * POINTS_PER_BLOCK;
+			task(first, std::min<unsigned int>(POINTS_PER_BLOCK, count - first));
+		});
+	}
+
+	/**
+	 * Runs task(i) for every point index in [0, count), in blocks spread over info's threads.
+	 * @param[in] info  Information to assist generation.
+	 * @param[in] count Number of points.
+	 * @param[in] task  Task to run for each point, called concurrently when more than one thread is used.
+	 */
+	template<typename Task>
+	static void forEachPoint( const PointGenInfo& info, unsigned int count, const Task& task ) {
+		forEachBlock(info, count, [&]( unsigned int first, unsigned int blockCount ) {
+			for( unsigned int i = first; i < first + blockCount; ++i ) {
+				task(i);
+			}
+		});
+	}
+
+	/**
+	 * Generates a block of uniform points in a box.
+	 * @param[in]  info       Information to assist generation.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points, up to POINTS_PER_BLOCK.
+	 * @param[in]  box        Box to generate points in.
+	 * @param[out] outBlock   Generated points.
+	 */
+	static void boxBlock( const PointGenInfo& info, Stream stream, unsigned int firstIndex, unsigned int count, const BoundingBox& box, PointBlock& outBlock ) {
+		Random<float, int>(info.seed).boxPoints(stream, firstIndex, count, box, outBlock.x, outBlock.y, outBlock.z);
+		outBlock.count = count;
+	}
+
+	/**
+	 * Generates a block of normally distributed points around a center.
+	 * @param[in]  info       Information to assist generation.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points, up to POINTS_PER_BLOCK.
+	 * @param[in]  center     Mean of the points.
+	 * @param[in]  deviation  Standard deviation along each axis.
+	 * @param[out] outBlock   Generated points.
+	 */
+	static void gaussianBlock( const PointGenInfo& info, Stream stream, unsigned int firstIndex, unsigned int count, const cc::Vec3f& center, float deviation, PointBlock& outBlock ) {
+		Random<float, int>(info.seed).gaussianPoints(stream, firstIndex, count, center, deviation, outBlock.x, outBlock.y, outBlock.z);
+		outBlock.count = count;
+	}
+
+	/**
+	 * Generates uniform points in a box a block at a time on the calling thread.
+	 * @param[in]  info       Information to assist generation.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points.
+	 * @param[in]  box        Box to generate points in.
+	 * @param[out] outPoints  Array of count points to fill.
+	 */
+	static void boxPoints( const PointGenInfo& info, Stream stream, unsigned int firstIndex, unsigned int count, const BoundingBox& box, cc::Vec3f* outPoints ) {
+		PointBlock block;
+		for( unsigned int first = 0; first < count; first += POINTS_PER_BLOCK ) {
+			boxBlock(info, stream, firstIndex + first, std::min<unsigned int>(POINTS_PER_BLOCK, count - first), box, block);
+			block.copyTo(outPoints + first);
+		}
+	}
+
+	/**
+	 * Generates normally distributed points around a center a block at a time on the calling thread.
+	 * @param[in]  info       Information to assist generation.
+	 * @param[in]  stream     Stream to draw from.
+	 * @param[in]  firstIndex Index of the first point within the stream.
+	 * @param[in]  count      Number of points.
+	 * @param[in]  center     Mean of the points.
+	 * @param[in]  deviation  Standard deviation along each axis.
+	 * @param[out] outPoints  Array of count points to fill.
+	 */
+	static void gaussianPoints( const PointGenInfo& info, Stream stream, unsigned int firstIndex, unsigned int count, const cc::Vec3f& center, float deviation, cc::Vec3f* outPoints ) {
+		PointBlock block;
+		for( unsigned int first = 0; first < count; first += POINTS_PER_BLOCK ) {
+			gaussianBlock(info, stream, firstIndex + first, std::min<unsigned int>(POINTS_PER_BLOCK, count - first), center, deviation, block);
+			block.copyTo(outPoints + first);
+		}
+	}
+
+	/**
+	 * Appends random points within the bounding box, and within the mesh if info has one, spread over info's threads.
+	 * Without a mesh, points are generated a block at a time.  Points that could not be placed inside of the mesh are dropped.
+	 * @param[in]  boundingBox Input geometry's bounding box.
+	 * @param[in]  info        Information to assist generation.
+	 * @param[in]  stream      Stream to draw from.
+	 * @param[in]  count       Number of points to try.
+	 * @param[out] outPoints   Vector to append the generated points to.
+	 */
+	void randomPoints( const BoundingBox& boundingBox, const PointGenInfo& info, Stream stream, unsigned int count, std::vector<cc::Vec3f>& outPoints ) const {
+		const size_t firstPoint = outPoints.size();
+		outPoints.resize(firstPoint + count);
+		cc::Vec3f* points = outPoints.data() + firstPoint;
+		if( nullptr == info.insideMesh ) {
+			forEachBlock(info, count, [&]( unsigned int first, unsigned int blockCount ) {
+				boxPoints(info, stream, first, blockCount, boundingBox, points + first);
+			});
+			return;
+		}
+		std::vector<char> placed(count, 0);
+		forEachPoint(info, count, [&]( unsigned int i ) {
+			Random<float, int> rnd(info.seed, stream, i);
+			placed[i] = randomPoint(rnd, boundingBox, info, points[i]);
+		});
+		dropUnplacedPoints(outPoints, firstPoint, placed);
+	}
+
+	/**
+	 * Generates a random point within the bounding box, and within the mesh if info has one.
+	 * @param[in]  rnd         Random generator to draw from.
+	 * @param[in]  boundingBox Input geometry's bounding box.
+	 * @param[in]  info        Information to assist generation.
+	 * @param[out] outPoint    Random point.
+	 * @returns False if no point inside of the mesh was found, in which case outPoint is unchanged.
+	 */
+	bool randomPoint( Random<float, int>& rnd, const BoundingBox& boundingBox, const PointGenInfo& info, cc::Vec3f& outPoint ) const {
+		if( nullptr == info.insideMesh ) {
+			outPoint = rnd.pointInBBox(boundingBox);
+			return true;
+		}
+		// rejection sampling only costs a grid lookup per attempt, so even thin meshes filling little of the box are cheap
+		for( unsigned int attempt = 0; attempt < MAX_INSIDE_ATTEMPTS; ++attempt ) {
+			const cc::Vec3f point = rnd.pointInBBox(boundingBox);
+			if( info.insideMesh->contains(point) ) {
+				outPoint = point;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Moves a point by a random offset along each axis, and keeps it within the mesh if info has one.
+	 * @param[in]  rnd         Random generator to draw from.
+	 * @param[in]  point       Point to move.
+	 * @param[in]  amount      Maximum offset along each axis.
+	 * @param[in]  boundingBox Input geometry's bounding box.
+	 * @param[in]  info        Information to assist generation.
+	 * @param[out] outPoint    Moved point.
+	 * @returns False if no point inside of the mesh was found, in which case outPoint is unchanged.
+	 */
+	bool fluxPoint( Random<float, int>& rnd, const cc::Vec3f& point, float amount, const BoundingBox& boundingBox, const PointGenInfo& info, cc::Vec3f& outPoint ) const {
+		if( nullptr == info.insideMesh ) {
+			outPoint = point + cc::Vec3f(rnd.nextReal(-amount, amount), rnd.nextReal(-amount, amount), rnd.nextReal(-amount, amount));
+			return true;
+		}
+		for( unsigned int attempt = 0; attempt < MAX_FLUX_ATTEMPTS; ++attempt ) {
+			const cc::Vec3f moved = point + cc::Vec3f(rnd.nextReal(-amount, amount), rnd.nextReal(-amount, amount), rnd.nextReal(-amount, amount));
+			if( info.insideMesh->contains(moved) ) {
+				outPoint = moved;
+				return true;
+			}
+		}
+		// no offset reaches inside of the mesh from this point, so take one from anywhere inside of it instead
+		return randomPoint(rnd, boundingBox, info, outPoint);
+	}
+
+	/**
+	 * Removes points that could not be placed inside of the mesh, keeping the rest in order, and warns if any were removed.
+	 * @param[in,out] points Points to compact.
+	 * @param[in]     first  Index of the first point that placed covers.
+	 * @param[in]     placed Whether each point from first onward was placed.
+	 * @returns Number of points removed.
+	 */
+	static size_t dropUnplacedPoints( std::vector<cc::Vec3f>& points, size_t first, const std::vector<char>& placed ) {
+		size_t keptCount = first;
+		for( size_t i = 0; i < placed.size(); ++i ) {
+			if( placed[i] ) {
+				points[keptCount++] = points[first + i];
+			}
+		}
+		const size_t droppedCount = first + placed.size() - keptCount;
+		if( droppedCount > 0 ) {
+			points.erase(points.begin() + keptCount, points.begin() + first + placed.size());
+			MTLog::instance()->log("Warning: " + std::to_string(droppedCount) + " points could not be placed inside of the mesh and were dropped.\n");
+		}
+		return droppedCount;
+	}
+
+private:
+	static const unsigned int MAX_INSIDE_ATTEMPTS = 10000;
+	static const unsigned int MAX_FLUX_ATTEMPTS = 100;
 };
 
 #endif /* __isamplepointgen__ */
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "Bezier/BezierPointGen.hpp"
 #include "Cluster/ClusterPointGen.hpp"
 #include "TestPointGen/TestPointGen.hpp"
+#include "Poisson/PoissonPointGen.hpp"
+#include "Surface/SurfacePointGen.hpp"
 
 class PointGenFactory {
 public:
@@ -15,7 +17,9 @@ public:
 		Uniform,
 		Bezier,
 		Cluster,
-		Test
+		Test,
+		Poisson,
+		Surface
 	};
 
 	static std::unique_ptr<IPointGen> create( Type type ) {
@@ -35,6 +39,14 @@ public:
 			case Type::Test: {
 				return std::make_unique<TestPointGen>();
 			}
+
+			case Type::Poisson: {
+				return std::make_unique<PoissonPointGen>();
+			}
+
+			case Type::Surface: {
+				return std::make_unique<SurfacePointGen>();
+			}
 		}
 		return nullptr;
 	}
@@ -2,9 +2,27 @@
 #define __point_gen_info__
 
 #include <vector>
+#include <string>
+#include <memory>
 #include <cc/Vec3.hpp>
+#include "../MeshInsideTest.hpp"
 
 struct PointGenInfo {
+	// a crack of bezier fracturing
+	struct CrackInfo {
+		// control points of the path; two are its ends and none makes it random (see BezierPointGen)
+		std::vector<cc::Vec3f> controlPoints;
+		// points sampled along each curve of the path
+		unsigned int samples;
+		// fluctuation percentage of the sampled points
+		double flux;
+
+		CrackInfo() {
+			samples = 0;
+			flux = 0.0;
+		}
+	};
+
 	// seed used to reproduce point generation
 	unsigned int seed;
 	// amount of uniformly scattered points to generate
@@ -21,6 +39,23 @@ struct PointGenInfo {
 	std::vector<cc::Vec3f> userPoints;
 	// minimum distance for auto generated points in bezier mode as a percentage (0..100)
 	double minBezierDistance;
+	// maximum radius of weighted sample points as a percentage (0..100) of the bounding box's diagonal
+	double radiusPercent;
+	// minimum distance between poisson points as a percentage (0..100) of the bounding box's diagonal; 0 picks it from uniformCount
+	double minSpacing;
+	// optional precomputed blue noise tile that poisson points are copied from, generated on first use
+	std::string blueNoiseTilePath;
+	// optional mesh that random points are kept inside of, rather than only its bounding box
+	std::shared_ptr<const MeshInsideTest> insideMesh;
+	// surface that surface points are sampled over, with an optional density per vertex (empty weighs triangles by area alone)
+	std::shared_ptr<const Model> surfaceModel;
+	std::vector<float> surfaceWeights;
+	// mean distance that surface points are moved inward as a percentage (0..100) of the bounding box's diagonal
+	double surfaceDepth;
+	// bezier cracks sampled together into one set of points; empty makes one crack from userPoints, samples, and flux
+	std::vector<CrackInfo> cracks;
+	// number of threads to generate points on; points are the same for any number
+	unsigned int threadCount;
 
 	PointGenInfo() {
 		seed = 0;
@@ -31,6 +66,10 @@ struct PointGenInfo {
 		flux = 0.0;
 		userPoints = std::vector<cc::Vec3f>();
 		minBezierDistance = 50.0;
+		radiusPercent = 0.0;
+		minSpacing = 0.0;
+		surfaceDepth = 1.0;
+		threadCount = 1;
 	}
 };
 
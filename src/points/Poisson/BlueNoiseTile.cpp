@@ -0,0 +1,69 @@
+#include "BlueNoiseTile.hpp"
+#include <fstream>
+#include <algorithm>
+
+static const char TILE_MAGIC[4] = {'H', 'D', 'N', 'B'};
+static const uint32_t TILE_VERSION = 1;
+
+BlueNoiseTile::BlueNoiseTile()
+	: _header(nullptr), _points(nullptr) {
+}
+
+bool BlueNoiseTile::save( const std::string& path, const std::vector<cc::Vec3f>& points, float spacing ) {
+	Header header;
+	std::copy(TILE_MAGIC, TILE_MAGIC + 4, header.magic);
+	header.version = TILE_VERSION;
+	header.pointCount = static_cast<uint32_t>(points.size());
+	header.spacing = spacing;
+
+	std::vector<float> coords;
+	coords.reserve(points.size() * 3);
+	for( const auto& point : points ) {
+		coords.push_back(point.x);
+		coords.push_back(point.y);
+		coords.push_back(point.z);
+	}
+
+	std::ofstream out(path, std::ios::binary | std::ios::trunc);
+	if( !out.is_open() ) {
+		return false;
+	}
+	out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	if( !coords.empty() ) {
+		out.write(reinterpret_cast<const char*>(coords.data()), coords.size() * sizeof(float));
+	}
+	return out.good();
+}
+
+bool BlueNoiseTile::load( const std::string& path ) {
+	_header = nullptr;
+	if( !_file.open(path) || _file.getSize() < sizeof(Header) ) {
+		return false;
+	}
+
+	const unsigned char* data = _file.getData();
+	const Header* header = reinterpret_cast<const Header*>(data);
+	if( !std::equal(TILE_MAGIC, TILE_MAGIC + 4, header->magic) || header->version != TILE_VERSION || !(header->spacing > 0.0f) ) {
+		return false;
+	}
+	if( _file.getSize() < sizeof(Header) + sizeof(float) * 3 * header->pointCount ) {
+		return false;
+	}
+
+	_points = reinterpret_cast<const float*>(data + sizeof(Header));
+	_header = header;
+	return true;
+}
+
+uint32_t BlueNoiseTile::getPointCount() const {
+	return (_header != nullptr) ? _header->pointCount : 0;
+}
+
+cc::Vec3f BlueNoiseTile::getPoint( uint32_t point ) const {
+	const float* coords = _points + point * 3;
+	return cc::Vec3f(coords[0], coords[1], coords[2]);
+}
+
+float BlueNoiseTile::getSpacing() const {
+	return (_header != nullptr) ? _header->spacing : 0.0f;
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef __blue_noise_tile__
+#define __blue_noise_tile__
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cc/Vec3.hpp>
+#include <MappedFile.hpp>
+
+// a precomputed set of poisson disk points over the unit cube whose spacing holds across its sides, so that copies of it
+// tile space.  tiles are stored as a compact (little endian) binary file that is memory mapped and read in place:
+//    Header
+//    float[3][pointCount]    points within the unit cube
+class BlueNoiseTile {
+public:
+	struct Header {
+		char magic[4];
+		uint32_t version;
+		uint32_t pointCount;
+		float spacing; // minimum distance between any two points, including across the sides of the cube
+	};
+
+public:
+	BlueNoiseTile();
+
+	/**
+	 * Writes a tile file.
+	 * @param[in] path    Path of the file to write.
+	 * @param[in] points  Points within the unit cube.
+	 * @param[in] spacing Minimum distance between the points.
+	 * @returns True upon success; false otherwise.
+	 */
+	static bool save( const std::string& path, const std::vector<cc::Vec3f>& points, float spacing );
+
+	/**
+	 * Maps a tile file for reading.
+	 * @param[in] path Path of the file to read.
+	 * @returns True if the file is a valid tile; false otherwise.
+	 */
+	bool load( const std::string& path );
+
+	uint32_t getPointCount() const;
+	cc::Vec3f getPoint( uint32_t point ) const;
+	float getSpacing() const;
+
+private:
+	MappedFile _file;
+	const Header* _header;
+	const float* _points;
+};
+
+#endif /* __blue_noise_tile__ */
\ No newline at end of file
@@ -0,0 +1,233 @@
+#include "PoissonPointGen.hpp"
+#include "BlueNoiseTile.hpp"
+#include <Random.hpp>
+#include <MTLog.hpp>
+#include <cmath>
+#include <algorithm>
+
+// candidates tried around a point before it is retired
+static const int CANDIDATE_COUNT = 30;
+// points per generated tile
+static const unsigned int TILE_POINT_COUNT = 4096;
+// volume per point in units of spacing cubed once sample has filled a volume (measured)
+static const float VOLUME_PER_POINT = 1.65f;
+// most grid cells, or tile points laid over the box, before refusing rather than running out of memory
+static const double MAX_GRID_CELLS = 33554432.0;
+
+PoissonPointGen::PoissonPointGen()
+	: IPointGen() {
+}
+
+PoissonPointGen::~PoissonPointGen() {
+}
+
+void PoissonPointGen::generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) {
+	const cc::Vec3f min(boundingBox.minX(), boundingBox.minY(), boundingBox.minZ());
+	const cc::Vec3f size = boundingBox.getHalfExtents() * 2.0f;
+	const float volume = size.x * size.y * size.z;
+	float spacing = 0.0f;
+	if( info.minSpacing > 0.0 ) {
+		spacing = cc::math::percent<float>(boundingBox.getDiagonalDistance(), static_cast<float>(info.minSpacing));
+	} else if( info.uniformCount > 0 && volume > 0.0f ) {
+		spacing = spacingForCount(volume, info.uniformCount);
+	}
+	if( spacing <= 0.0f ) {
+		if( info.minSpacing > 0.0 ) {
+			MTLog::instance()->log("Warning: Bounding box has no size, so no poisson points were generated.\n");
+		} else if( 0 == info.uniformCount ) {
+			MTLog::instance()->log("Warning: No poisson points were generated as neither -uniformCount (-uc) nor -minSpacing (-msp) were given.\n");
+		} else {
+			MTLog::instance()->log("Warning: Bounding box is flat, so no poisson points were generated.  Give -minSpacing (-msp) to spread them over a flat mesh.\n");
+		}
+		return;
+	}
+
+	const size_t firstPoint = outPoints.size();
+	if( !fillBox(boundingBox, info, spacing, outPoints) ) {
+		return;
+	}
+	if( nullptr == info.insideMesh ) {
+		return;
+	}
+	const auto keepInside = [&]() {
+		const auto outside = std::remove_if(outPoints.begin() + firstPoint, outPoints.end(), [&]( const cc::Vec3f& point ) {
+			return !info.insideMesh->contains(point);
+		});
+		outPoints.erase(outside, outPoints.end());
+	};
+	const size_t boxCount = outPoints.size() - firstPoint;
+	keepInside();
+
+	// the count is wanted within the mesh rather than its box, so shrink the spacing by how little of the box the mesh filled
+	const size_t meshCount = outPoints.size() - firstPoint;
+	if( info.minSpacing <= 0.0 && meshCount > 0 && meshCount < boxCount ) {
+		const float filled = static_cast<float>(meshCount) / static_cast<float>(boxCount);
+		outPoints.resize(firstPoint);
+		if( !fillBox(boundingBox, info, spacing * cbrtf(filled), outPoints) ) {
+			return;
+		}
+		keepInside();
+	}
+}
+
+bool PoissonPointGen::fillBox( const BoundingBox& boundingBox, const PointGenInfo& info, float spacing, std::vector<cc::Vec3f>& outPoints ) const {
+	const cc::Vec3f min(boundingBox.minX(), boundingBox.minY(), boundingBox.minZ());
+	const cc::Vec3f size = boundingBox.getHalfExtents() * 2.0f;
+
+	if( info.blueNoiseTilePath.empty() ) {
+		return sample(min, size, spacing, false, info.seed, outPoints);
+	}
+
+	// tiles are generated once and reused by every later run
+	BlueNoiseTile tile;
+	if( !tile.load(info.blueNoiseTilePath) ) {
+		std::vector<cc::Vec3f> tilePoints;
+		const float tileSpacing = spacingForCount(1.0f, TILE_POINT_COUNT);
+		sample(cc::Vec3f(0.0f, 0.0f, 0.0f), cc::Vec3f(1.0f, 1.0f, 1.0f), tileSpacing, true, info.seed, tilePoints);
+		if( !BlueNoiseTile::save(info.blueNoiseTilePath, tilePoints, tileSpacing) || !tile.load(info.blueNoiseTilePath) ) {
+			MTLog::instance()->log("Warning: Failed to save blue noise tile to " + info.blueNoiseTilePath + ".  Generating points without it.\n");
+			return sample(min, size, spacing, false, info.seed, outPoints);
+		}
+		MTLog::instance()->log("Saved blue noise tile of " + std::to_string(tilePoints.size()) + " points to " + info.blueNoiseTilePath + ".\n");
+	}
+
+	// scale the tile to the spacing, and move the copies by a random offset so that seeds give different points
+	const float tileSize = spacing / tile.getSpacing();
+	Random<float, int> rnd(info.seed);
+	const cc::Vec3f origin = min - cc::Vec3f(rnd.nextReal(0.0f, tileSize), rnd.nextReal(0.0f, tileSize), rnd.nextReal(0.0f, tileSize));
+	const float tilesXf = ceilf((size.x + tileSize) / tileSize);
+	const float tilesYf = ceilf((size.y + tileSize) / tileSize);
+	const float tilesZf = ceilf((size.z + tileSize) / tileSize);
+	const uint32_t pointCount = tile.getPointCount();
+	if( static_cast<double>(tilesXf) * tilesYf * tilesZf * pointCount > MAX_GRID_CELLS ) {
+		MTLog::instance()->log("Error: Poisson spacing is too small for the bounding box.  Increase the spacing or lower the count.\n");
+		return false;
+	}
+	const int tilesX = static_cast<int>(tilesXf);
+	const int tilesY = static_cast<int>(tilesYf);
+	const int tilesZ = static_cast<int>(tilesZf);
+	const cc::Vec3f max = min + size;
+	for( int z = 0; z < tilesZ; ++z ) {
+		for( int y = 0; y < tilesY; ++y ) {
+			for( int x = 0; x < tilesX; ++x ) {
+				const cc::Vec3f tileMin = origin + cc::Vec3f(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) * tileSize;
+				for( uint32_t i = 0; i < pointCount; ++i ) {
+					const cc::Vec3f point = tileMin + tile.getPoint(i) * tileSize;
+					if( point.x < min.x || point.y < min.y || point.z < min.z || point.x > max.x || point.y > max.y || point.z > max.z ) {
+						continue;
+					}
+					outPoints.push_back(point);
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool PoissonPointGen::sample( const cc::Vec3f& min, const cc::Vec3f& size, float spacing, bool periodic, unsigned int seed, std::vector<cc::Vec3f>& outPoints ) {
+	// grid cells are small enough to hold at most one point, so a point only needs comparing against the 5x5x5 cells around it.
+	// cells exactly divide the box so that periodic boxes wrap whole cells.
+	const float maxCellSize = spacing / sqrtf(3.0f);
+	const float resXf = std::max<float>(1.0f, ceilf(size.x / maxCellSize));
+	const float resYf = std::max<float>(1.0f, ceilf(size.y / maxCellSize));
+	const float resZf = std::max<float>(1.0f, ceilf(size.z / maxCellSize));
+	if( static_cast<double>(resXf) * resYf * resZf > MAX_GRID_CELLS ) {
+		MTLog::instance()->log("Error: Poisson spacing is too small for the bounding box.  Increase the spacing or lower the count.\n");
+		return false;
+	}
+	const int resX = static_cast<int>(resXf);
+	const int resY = static_cast<int>(resYf);
+	const int resZ = static_cast<int>(resZf);
+	const cc::Vec3f cellSize(size.x / static_cast<float>(resX), size.y / static_cast<float>(resY), size.z / static_cast<float>(resZ));
+	std::vector<int> grid(static_cast<size_t>(resX) * resY * resZ, -1);
+	const auto cellOf = [&]( float value, float origin, float cell, int res ) {
+		return cc::math::clamp<int>(static_cast<int>((value - origin) / cell), 0, res-1);
+	};
+	// periodic boxes compare against the nearest copy of each point
+	const auto offset = [&]( float delta, float extent ) {
+		if( periodic ) {
+			delta -= extent * roundf(delta / extent);
+		}
+		return delta;
+	};
+
+	std::vector<cc::Vec3f> points;
+	const auto fits = [&]( const cc::Vec3f& candidate ) {
+		const int cx = cellOf(candidate.x, min.x, cellSize.x, resX);
+		const int cy = cellOf(candidate.y, min.y, cellSize.y, resY);
+		const int cz = cellOf(candidate.z, min.z, cellSize.z, resZ);
+		for( int dz = -2; dz <= 2; ++dz ) {
+			for( int dy = -2; dy <= 2; ++dy ) {
+				for( int dx = -2; dx <= 2; ++dx ) {
+					int x = cx + dx;
+					int y = cy + dy;
+					int z = cz + dz;
+					if( periodic ) {
+						x = (x + resX) % resX;
+						y = (y + resY) % resY;
+						z = (z + resZ) % resZ;
+					} else if( x < 0 || y < 0 || z < 0 || x >= resX || y >= resY || z >= resZ ) {
+						continue;
+					}
+					const int other = grid[x + resX * (y + resY * z)];
+					if( other < 0 ) {
+						continue;
+					}
+					const cc::Vec3f& point = points[other];
+					const cc::Vec3f delta(offset(candidate.x - point.x, size.x), offset(candidate.y - point.y, size.y), offset(candidate.z - point.z, size.z));
+					if( delta.dot(delta) < spacing * spacing ) {
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	};
+	const auto add = [&]( const cc::Vec3f& point ) {
+		grid[cellOf(point.x, min.x, cellSize.x, resX) + resX * (cellOf(point.y, min.y, cellSize.y, resY) + resY * cellOf(point.z, min.z, cellSize.z, resZ))] = static_cast<int>(points.size());
+		points.push_back(point);
+	};
+
+	Random<float, int> rnd(seed);
+	add(min + cc::Vec3f(rnd.nextReal(0.0f, size.x), rnd.nextReal(0.0f, size.y), rnd.nextReal(0.0f, size.z)));
+
+	// grow out from points still active, trying candidates uniformly spread through the shell between one and two spacings
+	std::vector<int> active(1, 0);
+	while( !active.empty() ) {
+		const int slot = rnd.nextInt(0, static_cast<int>(active.size()) - 1);
+		const cc::Vec3f source = points[active[slot]];
+		bool added = false;
+		for( int attempt = 0; attempt < CANDIDATE_COUNT; ++attempt ) {
+			const float cosTheta = rnd.nextReal(-1.0f, 1.0f);
+			const float sinTheta = sqrtf(std::max<float>(0.0f, 1.0f - cosTheta * cosTheta));
+			const float phi = rnd.nextReal(0.0f, 6.28318531f);
+			const float distance = spacing * cbrtf(1.0f + 7.0f * rnd.nextReal());
+			cc::Vec3f candidate = source + cc::Vec3f(sinTheta * cosf(phi), sinTheta * sinf(phi), cosTheta) * distance;
+			if( periodic ) {
+				candidate.x = min.x + fmodf(fmodf(candidate.x - min.x, size.x) + size.x, size.x);
+				candidate.y = min.y + fmodf(fmodf(candidate.y - min.y, size.y) + size.y, size.y);
+				candidate.z = min.z + fmodf(fmodf(candidate.z - min.z, size.z) + size.z, size.z);
+			} else if( candidate.x < min.x || candidate.y < min.y || candidate.z < min.z || candidate.x > min.x + size.x || candidate.y > min.y + size.y || candidate.z > min.z + size.z ) {
+				continue;
+			}
+			if( !fits(candidate) ) {
+				continue;
+			}
+			active.push_back(static_cast<int>(points.size()));
+			add(candidate);
+			added = true;
+			break;
+		}
+		if( !added ) {
+			active[slot] = active.back();
+			active.pop_back();
+		}
+	}
+
+	outPoints.insert(outPoints.end(), points.begin(), points.end());
+	return true;
+}
+
+float PoissonPointGen::spacingForCount( float volume, unsigned int count ) {
+	return cbrtf(volume / (VOLUME_PER_POINT * static_cast<float>(std::max<unsigned int>(1, count))));
+}
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef __poisson_point_gen__
+#define __poisson_point_gen__
+
+#include <points/IPointGen.hpp>
+
+/**
+ * Generates blue noise points that are no closer than a minimum spacing, which avoids the clumps of uniform points that
+ * make slivers.  The spacing is PointGenInfo::minSpacing, or else is picked so that around PointGenInfo::uniformCount
+ * points fill the bounding box.  Points are grown out from existing points (Bridson's algorithm) using a grid so that
+ * only nearby points are compared, which is linear in the number of points.  If PointGenInfo::blueNoiseTilePath is given,
+ * copies of a precomputed tile are laid over the bounding box instead, generating (and saving) the tile first if needed.
+ * Points outside of PointGenInfo::insideMesh are dropped, and a count-derived spacing is shrunk to suit the mesh's volume.
+ */
+class PoissonPointGen : public IPointGen {
+public:
+	PoissonPointGen();
+	~PoissonPointGen();
+
+	virtual void generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) override;
+
+	/**
+	 * Generates poisson disk points within a box.
+	 * @param[in]  min       Minimum corner of the box.
+	 * @param[in]  size      Size of the box.
+	 * @param[in]  spacing   Minimum distance between points.
+	 * @param[in]  periodic  Whether the spacing holds across the sides of the box, so that copies of the points tile space.
+	 * @param[in]  seed      Seed of the random generation.
+	 * @param[out] outPoints Vector to append the generated points to.
+	 * @returns False if the spacing is too small for the box to be sampled, in which case no points are appended.
+	 */
+	static bool sample( const cc::Vec3f& min, const cc::Vec3f& size, float spacing, bool periodic, unsigned int seed, std::vector<cc::Vec3f>& outPoints );
+
+	/**
+	 * Estimates the spacing for which sample fills a volume with a number of points.
+	 * @param[in] volume Volume to fill.
+	 * @param[in] count  Number of points wanted.
+	 * @returns Minimum spacing between points.
+	 */
+	static float spacingForCount( float volume, unsigned int count );
+
+private:
+	/**
+	 * Fills the bounding box with points, either by sampling or from the blue noise tile.
+	 * @param[in]  boundingBox Bounding box to fill.
+	 * @param[in]  info        Information to assist generation.
+	 * @param[in]  spacing     Minimum distance between points.
+	 * @param[out] outPoints   Vector to append the generated points to.
+	 * @returns False if the spacing is too small for the box to be filled, in which case no points are appended.
+	 */
+	bool fillBox( const BoundingBox& boundingBox, const PointGenInfo& info, float spacing, std::vector<cc::Vec3f>& outPoints ) const;
+};
+
+#endif /* __poisson_point_gen__ */
\ No newline at end of file
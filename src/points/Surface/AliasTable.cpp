@@ -0,0 +1,58 @@
+#include "AliasTable.hpp"
+#include <algorithm>
+
+AliasTable::AliasTable() {
+}
+
+bool AliasTable::build( const std::vector<float>& weights ) {
+	_thresholds.clear();
+	_aliases.clear();
+	double total = 0.0;
+	for( const float weight : weights ) {
+		total += std::max<float>(0.0f, weight);
+	}
+	if( weights.empty() || total <= 0.0 ) {
+		return false;
+	}
+
+	// scale weights so that their mean is one, then split them into those under and over a full column
+	const size_t count = weights.size();
+	std::vector<double> scaled(count);
+	std::vector<uint32_t> under;
+	std::vector<uint32_t> over;
+	for( size_t i = 0; i < count; ++i ) {
+		scaled[i] = static_cast<double>(std::max<float>(0.0f, weights[i])) * static_cast<double>(count) / total;
+		(scaled[i] < 1.0 ? under : over).push_back(static_cast<uint32_t>(i));
+	}
+
+	// each light column is topped up from a heavy one, which then becomes light itself once it drops under one
+	_thresholds.resize(count, 1.0f);
+	_aliases.resize(count);
+	for( size_t i = 0; i < count; ++i ) {
+		_aliases[i] = static_cast<uint32_t>(i);
+	}
+	while( !under.empty() && !over.empty() ) {
+		const uint32_t light = under.back();
+		under.pop_back();
+		const uint32_t heavy = over.back();
+		_thresholds[light] = static_cast<float>(scaled[light]);
+		_aliases[light] = heavy;
+		scaled[heavy] -= 1.0 - scaled[light];
+		if( scaled[heavy] < 1.0 ) {
+			over.pop_back();
+			under.push_back(heavy);
+		}
+	}
+	// anything left over is a full column, give or take rounding
+	return true;
+}
+
+unsigned int AliasTable::sample( float column, float coin ) const {
+	const size_t count = _thresholds.size();
+	const size_t index = std::min<size_t>(count - 1, static_cast<size_t>(column * static_cast<float>(count)));
+	return (coin < _thresholds[index]) ? static_cast<unsigned int>(index) : _aliases[index];
+}
+
+size_t AliasTable::size() const {
+	return _thresholds.size();
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#ifndef __alias_table__
+#define __alias_table__
+
+#include <vector>
+#include <cstdint>
+
+/**
+ * Picks indices with probability proportional to their weights in constant time, no matter how many there are (vose's
+ * alias method).  Each index gets a column of equal probability, holding the index itself up to a threshold and the
+ * index of a heavier weight (its alias) above it, so a pick is one column and one coin toss.
+ */
+class AliasTable {
+public:
+	AliasTable();
+
+	/**
+	 * Builds the table.
+	 * @param[in] weights Weight of each index.  Negative weights count as zero.
+	 * @returns True if any weight is positive; false otherwise.
+	 */
+	bool build( const std::vector<float>& weights );
+
+	/**
+	 * Picks an index.
+	 * @param[in] column Uniform value in [0, 1) choosing the column.
+	 * @param[in] coin   Uniform value in [0, 1) choosing between the column's index and its alias.
+	 * @returns Picked index.
+	 */
+	unsigned int sample( float column, float coin ) const;
+
+	size_t size() const;
+
+private:
+	std::vector<float> _thresholds;
+	std::vector<uint32_t> _aliases;
+};
+
+#endif /* __alias_table__ */
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "SurfacePointGen.hpp"
+#include "AliasTable.hpp"
+#include <MTLog.hpp>
+#include <cmath>
+
+// times the depth of a point outside of the mesh is halved to bring it back in, for parts thinner than the depth
+static const unsigned int MAX_DEPTH_HALVINGS = 4;
+
+SurfacePointGen::SurfacePointGen()
+	: IPointGen() {
+}
+
+SurfacePointGen::~SurfacePointGen() {
+}
+
+void SurfacePointGen::generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) {
+	if( nullptr == info.surfaceModel ) {
+		MTLog::instance()->log("Warning: No surface to sample.  Fracturing will not occur.\n");
+		return;
+	}
+	const std::vector<Vertex>& vertices = info.surfaceModel->getVertices();
+	const std::vector<int>& indices = info.surfaceModel->getIndices();
+	const size_t triangleCount = indices.size() / 3;
+	const bool hasWeights = (info.surfaceWeights.size() == vertices.size());
+
+	// triangles are weighted by area, scaled by the mean weight of their corners
+	std::vector<float> areas(triangleCount);
+	std::vector<float> triangleWeights(triangleCount);
+	std::vector<cc::Vec3f> inwards(triangleCount);
+	for( size_t i = 0; i < triangleCount; ++i ) {
+		const int* corners = &indices[i * 3];
+		const cc::Vec3f& a = vertices[corners[0]].position;
+		const cc::Vec3f normal = (vertices[corners[1]].position - a).cross(vertices[corners[2]].position - a);
+		const float length = normal.magnitude();
+		areas[i] = 0.5f * length;
+		inwards[i] = (length > 0.0f) ? normal * (-1.0f / length) : cc::Vec3f(0.0f, 0.0f, 0.0f);
+		const float weight = hasWeights ? (info.surfaceWeights[corners[0]] + info.surfaceWeights[corners[1]] + info.surfaceWeights[corners[2]]) / 3.0f : 1.0f;
+		triangleWeights[i] = areas[i] * weight;
+	}
+	AliasTable table;
+	if( !table.build(triangleWeights) ) {
+		if( !hasWeights || !table.build(areas) ) {
+			MTLog::instance()->log("Warning: Surface has no area to sample.  Fracturing will not occur.\n");
+			return;
+		}
+		MTLog::instance()->log("Warning: Surface weights are all zero.  Sampling by area alone.\n");
+	}
+
+	const float meanDepth = cc::math::percent<float>(boundingBox.getDiagonalDistance(), static_cast<float>(info.surfaceDepth));
+	const BoundingBox unitBox(cc::Vec3f(0.5f, 0.5f, 0.5f), cc::Vec3f(0.5f, 0.5f, 0.5f));
+	const size_t firstPoint = outPoints.size();
+	outPoints.resize(firstPoint + info.uniformCount);
+
+	// the triangle, position on it, and depth of each point come from two blocks of unit points drawn at once
+	forEachBlock(info, info.uniformCount, [&]( unsigned int first, unsigned int count ) {
+		PointBlock picks;
+		PointBlock coords;
+		boxBlock(info, STREAM_SURFACE, first, count, unitBox, picks);
+		boxBlock(info, STREAM_BARYCENTRIC, first, count, unitBox, coords);
+		for( unsigned int i = 0; i < count; ++i ) {
+			const unsigned int triangle = table.sample(picks.x[i], picks.y[i]);
+			const int* corners = &indices[triangle * 3];
+			const cc::Vec3f& a = vertices[corners[0]].position;
+			const cc::Vec3f& b = vertices[corners[1]].position;
+			const cc::Vec3f& c = vertices[corners[2]].position;
+
+			// the half of the unit square past its diagonal is folded back over it, which keeps points within the
+			// triangle and evenly spread without the square root of the usual mapping
+			float u = coords.x[i];
+			float v = coords.y[i];
+			if( u + v > 1.0f ) {
+				u = 1.0f - u;
+				v = 1.0f - v;
+			}
+			const cc::Vec3f onSurface = a + (b - a) * u + (c - a) * v;
+
+			// most points stay close to the surface, with fewer the deeper they go
+			float depth = -meanDepth * logf(1.0f - picks.z[i]);
+			cc::Vec3f point = onSurface + inwards[triangle] * depth;
+			for( unsigned int halving = 0; info.insideMesh != nullptr && halving < MAX_DEPTH_HALVINGS && !info.insideMesh->contains(point); ++halving ) {
+				depth *= 0.5f;
+				point = onSurface + inwards[triangle] * depth;
+			}
+			outPoints[firstPoint + first + i] = point;
+		}
+	});
+}
\ No newline at end of file
@@ -0,0 +1,21 @@
+#ifndef __surface_point_gen__
+#define __surface_point_gen__
+
+#include <points/IPointGen.hpp>
+
+/**
+ * Generates points near the surface of PointGenInfo::surfaceModel, where impacts and cracks start, so that detail goes
+ * where it is seen rather than being spread through the whole volume.  Triangles are picked through an alias table over
+ * their area times the mean of their corners' PointGenInfo::surfaceWeights (such as painted vertex colors), then points
+ * are placed on them and moved inward by exponentially distributed depths averaging PointGenInfo::surfaceDepth.
+ * PointGenInfo::uniformCount points are generated.
+ */
+class SurfacePointGen : public IPointGen {
+public:
+	SurfacePointGen();
+	~SurfacePointGen();
+
+	virtual void generateSamplePoints( const BoundingBox& boundingBox, const PointGenInfo& info, std::vector<cc::Vec3f>& outPoints ) override;
+};
+
+#endif /* __surface_point_gen__ */
\ No newline at end of file
@@ -1,16 +1,19 @@
 #include "CSGSlicer.hpp"
-#include <maya/MItMeshVertex.h>
 #include <maya/MIntArray.h>
 #include <maya/MPointArray.h>
 #include "../../ConvexTriangulator.hpp"
 #include "../../MayaHelper.hpp"
 #include <mutex>
+#include <limits>
 
 #define CSGJS_HEADER_ONLY
 #include "slicing/CSGSlicer/csgjs.cpp"
 
 static std::mutex CSGJS_CREATEMESH_MUTEX;
 
+// distance from a cell plane within which a vertex is considered to be on the plane (same as csgjs' own epsilon)
+static const float CLASSIFY_EPSILON = 0.00001f;
+
 CSGSlicer::CSGSlicer()
 	: IMeshSlicer() {
 }
@@ -19,65 +22,34 @@ CSGSlicer::~CSGSlicer() {
 }
 
 bool CSGSlicer::setSource( MFnMesh& source ) {
-	_sourceMesh = source.dagPath();
-	return true;
+	// cache the source once rather than reading it back from maya for every cell
+	MDagPath sourcePath = source.dagPath();
+	MayaHelper::copyMFnMeshToModel(sourcePath, _sourceModel);
+	return (_sourceModel.getVertices().size() != 0 && _sourceModel.getIndices().size() != 0);
 }
 
-bool CSGSlicer::slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh ) {
-	// copy maya mesh to csg.js model
-	csgjs_model jsModel;
-	MItMeshVertex it(_sourceMesh);
-	while( !it.isDone() ) {
-		csgjs_vertex vtx;
-		// get position
-		MPoint pos = it.position(MSpace::kWorld);
-		vtx.pos = csgjs_vector(static_cast<float>(pos.x), static_cast<float>(pos.y), static_cast<float>(pos.z));
-		// add position
-		jsModel.vertices.push_back(vtx);
-		it.next();
-	}
-	MIntArray triangleCounts;
-	MIntArray triangleVertices;
-	MFnMesh(_sourceMesh).getTriangles(triangleCounts, triangleVertices);
-	for( unsigned int i = 0; i < triangleVertices.length(); ++i ) {
-		jsModel.indices.push_back(triangleVertices[i]);
-	}
-
-	// convert cell into csgjs_model
-	csgjs_model cellModel;
-
-	int indexOffset = 0;
-	const auto& planePoints = cell.getPlanePoints();
-	for( const auto& points : planePoints ) {
-		for( const auto& pnt : points ) {
-			csgjs_vertex vtx;
-			vtx.pos = csgjs_vector(pnt.x, pnt.y, pnt.z);
-			cellModel.vertices.push_back(vtx);
-		}
-		const auto& indices = HadanConvexTriangulate(points);
-		for( const auto& idx : indices ) {
-			cellModel.indices.push_back(indexOffset + idx[0]);
-			cellModel.indices.push_back(indexOffset + idx[1]);
-			cellModel.indices.push_back(indexOffset + idx[2]);
-		}
+bool CSGSlicer::setSource( const Model& source ) {
+	_sourceModel = source;
+	return (_sourceModel.getVertices().size() != 0 && _sourceModel.getIndices().size() != 0);
+}
 
-		indexOffset += static_cast<int>(points.size());
+bool CSGSlicer::slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh ) {
+	Model outModel;
+	if( !slice(cell, outModel) ) {
+		return false;
 	}
 
-	// perform intersection
-	const csgjs_model result = csgjs_intersection(jsModel, cellModel);
-
 	// copy back to maya mesh
 	MPointArray pointArray;
-	for( const auto& vtx : result.vertices ) {
-		pointArray.append(MPoint(vtx.pos.x, vtx.pos.y, vtx.pos.z));
+	for( const auto& vtx : outModel.getVertices() ) {
+		pointArray.append(MPoint(vtx.position.x, vtx.position.y, vtx.position.z));
 	}
 	MIntArray faceConnects;
-	for( const auto& idx : result.indices ) {
+	for( const auto& idx : outModel.getIndices() ) {
 		faceConnects.append(idx);
 	}
 	MIntArray faceCounts;
-	for( size_t i = 0; i < result.indices.size() / 3; ++i ) {
+	for( size_t i = 0; i < outModel.getIndices().size() / 3; ++i ) {
 		faceCounts.append(3);
 	}
 	{
@@ -86,4 +58,171 @@ bool CSGSlicer::slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& ou
 	}
 
 	return true;
+}
+
+bool CSGSlicer::slice( const Cell& cell, Model& outModel ) {
+	// convert cell into csgjs_model and compute its bounds
+	const std::vector<cc::Vec3f>& cellVertices = cell.getVertices();
+	if( cellVertices.empty() || 0 == cell.getFaceCount() ) {
+		return false;
+	}
+	csgjs_model cellModel;
+	cc::Vec3f cellMin(std::numeric_limits<float>::max());
+	cc::Vec3f cellMax(-std::numeric_limits<float>::max());
+	cc::Vec3f cellCenter;
+	for( const auto& pnt : cellVertices ) {
+		cellModel.vertices.push_back(csgjs_vertex(csgjs_vector(pnt.x, pnt.y, pnt.z)));
+
+		cellCenter += pnt;
+		cellMin.x = (pnt.x < cellMin.x) ? pnt.x : cellMin.x;
+		cellMin.y = (pnt.y < cellMin.y) ? pnt.y : cellMin.y;
+		cellMin.z = (pnt.z < cellMin.z) ? pnt.z : cellMin.z;
+		cellMax.x = (pnt.x > cellMax.x) ? pnt.x : cellMax.x;
+		cellMax.y = (pnt.y > cellMax.y) ? pnt.y : cellMax.y;
+		cellMax.z = (pnt.z > cellMax.z) ? pnt.z : cellMax.z;
+	}
+	cellCenter /= static_cast<float>(cellVertices.size());
+
+	// triangulate each face and derive its plane, oriented so that the cell is on the plane's positive side
+	std::vector<Plane> cellPlanes;
+	std::vector<cc::Vec3f> facePoints;
+	for( unsigned int face = 0; face < cell.getFaceCount(); ++face ) {
+		const int faceSize = cell.getFaceSize(face);
+		const int* faceIndices = cell.getFaceIndices(face);
+
+		facePoints.clear();
+		for( int i = 0; i < faceSize; ++i ) {
+			facePoints.push_back(cellVertices[faceIndices[i]]);
+		}
+		// newell's method is robust to the near-degenerate faces voronoi cells often have
+		cc::Vec3f normal;
+		for( int i = 0; i < faceSize; ++i ) {
+			const cc::Vec3f& curr = facePoints[i];
+			const cc::Vec3f& next = facePoints[(i+1) % faceSize];
+			normal.x += (curr.y - next.y) * (curr.z + next.z);
+			normal.y += (curr.z - next.z) * (curr.x + next.x);
+			normal.z += (curr.x - next.x) * (curr.y + next.y);
+		}
+		const bool hasNormal = normal.sqrMagnitude() > 0.0f;
+		Plane plane;
+		bool isWoundOutward = false;
+		if( hasNormal ) {
+			plane = Plane::constructFromPointNormal(facePoints[0], normal);
+			if( plane.signedDistance(cellCenter) < 0.0f ) {
+				plane.normal = -plane.normal;
+				plane.constant = -plane.constant;
+				isWoundOutward = true;
+			}
+		}
+
+		// the triangulation reverses the face's winding, which suits faces wound clockwise from outside (as voro++'s are).
+		// faces wound the other way are flipped back, so that csgjs always sees the cell's triangles facing out of it.
+		const auto& indices = HadanConvexTriangulate(facePoints);
+		for( const auto& idx : indices ) {
+			cellModel.indices.push_back(faceIndices[idx[0]]);
+			cellModel.indices.push_back(faceIndices[isWoundOutward ? idx[2] : idx[1]]);
+			cellModel.indices.push_back(faceIndices[isWoundOutward ? idx[1] : idx[2]]);
+		}
+
+		if( hasNormal ) {
+			cellPlanes.push_back(plane);
+		}
+	}
+	if( cellModel.indices.empty() ) {
+		return false;
+	}
+
+	// classify source triangles; only those crossing the cell's boundary need to go through the bsp
+	const std::vector<Vertex>& srcVertices = _sourceModel.getVertices();
+	const std::vector<int>& srcIndices = _sourceModel.getIndices();
+	csgjs_model straddlingModel;
+	csgjs_model insideModel;
+	for( size_t i = 0; i + 2 < srcIndices.size(); i += 3 ) {
+		csgjs_model* target = nullptr;
+		switch( classifyTriangle(i, cellMin, cellMax, cellPlanes) ) {
+			case TriangleClass::Outside: {
+				continue;
+			}
+			case TriangleClass::Inside: {
+				target = &insideModel;
+				break;
+			}
+			case TriangleClass::Straddling: {
+				target = &straddlingModel;
+				break;
+			}
+		}
+		for( size_t j = 0; j < 3; ++j ) {
+			const cc::Vec3f& pos = srcVertices[srcIndices[i+j]].position;
+			target->indices.push_back(static_cast<int>(target->vertices.size()));
+			target->vertices.push_back(csgjs_vertex(csgjs_vector(pos.x, pos.y, pos.z)));
+		}
+	}
+
+	// perform intersection
+	csgjs_model result;
+	if( straddlingModel.indices.empty() && insideModel.indices.empty() ) {
+		// no surface inside of the cell, so the cell is either entirely solid or entirely empty
+		if( !_sourceModel.containsPoint(cellCenter) ) {
+			return false;
+		}
+		result = cellModel;
+	} else {
+		result = csgjs_intersection_prefiltered(straddlingModel, insideModel, cellModel);
+	}
+	if( result.indices.empty() ) {
+		return false;
+	}
+
+	// copy to output model
+	for( const auto& vtx : result.vertices ) {
+		Vertex outVtx;
+		outVtx.position = cc::Vec3f(vtx.pos.x, vtx.pos.y, vtx.pos.z);
+		outModel.addVertex(outVtx);
+	}
+	for( const auto& idx : result.indices ) {
+		outModel.addIndex(idx);
+	}
+
+	return true;
+}
+
+bool CSGSlicer::needsCellPlanes() const {
+	return false;
+}
+
+bool CSGSlicer::needsCellFaces() const {
+	return true;
+}
+
+CSGSlicer::TriangleClass CSGSlicer::classifyTriangle( size_t triangle, const cc::Vec3f& cellMin, const cc::Vec3f& cellMax, const std::vector<Plane>& planes ) const {
+	const std::vector<Vertex>& vertices = _sourceModel.getVertices();
+	const std::vector<int>& indices = _sourceModel.getIndices();
+	const cc::Vec3f& a = vertices[indices[triangle]].position;
+	const cc::Vec3f& b = vertices[indices[triangle+1]].position;
+	const cc::Vec3f& c = vertices[indices[triangle+2]].position;
+
+	// reject by bounding box first as it is the cheapest test
+	const cc::Vec3f triMin(std::min<float>(a.x, std::min<float>(b.x, c.x)), std::min<float>(a.y, std::min<float>(b.y, c.y)), std::min<float>(a.z, std::min<float>(b.z, c.z)));
+	const cc::Vec3f triMax(std::max<float>(a.x, std::max<float>(b.x, c.x)), std::max<float>(a.y, std::max<float>(b.y, c.y)), std::max<float>(a.z, std::max<float>(b.z, c.z)));
+	if( triMax.x < cellMin.x - CLASSIFY_EPSILON || triMin.x > cellMax.x + CLASSIFY_EPSILON ||
+	    triMax.y < cellMin.y - CLASSIFY_EPSILON || triMin.y > cellMax.y + CLASSIFY_EPSILON ||
+	    triMax.z < cellMin.z - CLASSIFY_EPSILON || triMin.z > cellMax.z + CLASSIFY_EPSILON ) {
+		return TriangleClass::Outside;
+	}
+
+	// then against each plane; fully behind any one plane is outside, fully in front of all planes is inside
+	bool inside = true;
+	for( const auto& plane : planes ) {
+		const float da = plane.signedDistance(a);
+		const float db = plane.signedDistance(b);
+		const float dc = plane.signedDistance(c);
+		if( da < -CLASSIFY_EPSILON && db < -CLASSIFY_EPSILON && dc < -CLASSIFY_EPSILON ) {
+			return TriangleClass::Outside;
+		}
+		if( da <= CLASSIFY_EPSILON || db <= CLASSIFY_EPSILON || dc <= CLASSIFY_EPSILON ) {
+			inside = false;
+		}
+	}
+	return inside ? TriangleClass::Inside : TriangleClass::Straddling;
 }
\ No newline at end of file
@@ -2,7 +2,7 @@
 #define __csg_slicer__
 
 #include <slicing/IMeshSlicer.hpp>
-#include <maya/MDagPath.h>
+#include "../../Model.hpp"
 
 class CSGSlicer : public IMeshSlicer {
 public:
@@ -10,10 +10,31 @@ public:
 	virtual ~CSGSlicer();
 
 	virtual bool setSource( MFnMesh& source ) override;
+	virtual bool setSource( const Model& source ) override;
 	virtual bool slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh ) override;
+	virtual bool slice( const Cell& cell, Model& outModel ) override;
+	virtual bool needsCellPlanes() const override;
+	virtual bool needsCellFaces() const override;
 
 private:
-	MDagPath _sourceMesh;
+	enum class TriangleClass {
+		Outside,   /**< Entirely outside of the cell; cannot contribute to the intersection. */
+		Inside,    /**< Entirely inside of the cell; passes through the intersection unchanged. */
+		Straddling /**< Crosses (or touches) the cell's boundary; must be clipped. */
+	};
+
+	/**
+	 * Classifies a source triangle against a cell.
+	 * @param[in] triangle Index of the first index of the triangle in the source model.
+	 * @param[in] cellMin  Minimum corner of the cell's bounding box.
+	 * @param[in] cellMax  Maximum corner of the cell's bounding box.
+	 * @param[in] planes   Planes of the cell, oriented so that the cell is on their positive side.
+	 * @returns Classification of the triangle.
+	 */
+	TriangleClass classifyTriangle( size_t triangle, const cc::Vec3f& cellMin, const cc::Vec3f& cellMax, const std::vector<Plane>& planes ) const;
+
+private:
+	Model _sourceModel;
 };
 
 #endif /* __csg_slicer__ */
\ No newline at end of file
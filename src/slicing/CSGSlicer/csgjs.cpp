@@ -64,6 +64,11 @@ csgjs_model csgjs_intersection(const csgjs_model & a, const csgjs_model & b);
 //csgjs_model_extended csgjs_intersection_extended( const csgjs_model_extended& a, const csgjs_model_extended& b );
 csgjs_model csgjs_difference(const csgjs_model & a, const csgjs_model & b);
 
+// Intersection of a closed source with a convex cell `b` whose triangles have already been classified against
+// the cell by the caller. Only `straddling` triangles are split and clipped; `inside` triangles lie strictly inside
+// the cell, so they only help decide which parts of the cell's faces are solid and are otherwise emitted unchanged.
+csgjs_model csgjs_intersection_prefiltered(const csgjs_model & straddling, const csgjs_model & inside, const csgjs_model & b);
+
 // IMPLEMENTATION BELOW ---------------------------------------------------------------------------
 
 #ifndef CSGJS_HEADER_ONLY
@@ -565,4 +570,35 @@ csgjs_model csgjs_difference(const csgjs_model & a, const csgjs_model & b)
 	return csgjs_operation(a, b, csg_subtract);
 }
 
+// Same sequence of clips as `csg_intersect`, except that the polygons of `a` that are known to be inside `b`
+// never enter `clipTo`. They still take part in building the tree of `a`, as the faces of `b` must be
+// classified against the whole local surface and not only against the part of it that crosses `b`.
+csgjs_model csgjs_intersection_prefiltered(const csgjs_model & straddling, const csgjs_model & inside, const csgjs_model & b)
+{
+	std::vector<csgjs_polygon> surface = csgjs_modelToPolygons(straddling);
+	const std::vector<csgjs_polygon> passthrough = csgjs_modelToPolygons(inside);
+	std::vector<csgjs_polygon> solid = surface;
+	solid.insert(solid.end(), passthrough.begin(), passthrough.end());
+
+	csgjs_csgnode * A = new csgjs_csgnode(solid);
+	csgjs_csgnode * B = new csgjs_csgnode(csgjs_modelToPolygons(b));
+	A->invert();
+	B->clipTo(A);
+	B->invert();
+	for (size_t i = 0; i < surface.size(); i++)
+		surface[i].flip();
+	surface = B->clipPolygons(surface);
+	B->clipTo(A);
+	B->invert();
+
+	std::vector<csgjs_polygon> polygons = B->allPolygons();
+	for (size_t i = 0; i < surface.size(); i++)
+		surface[i].flip();
+	polygons.insert(polygons.end(), surface.begin(), surface.end());
+	polygons.insert(polygons.end(), passthrough.begin(), passthrough.end());
+	delete A; A = 0;
+	delete B; B = 0;
+	return csgjs_modelFromPolygons(polygons);
+}
+
 #endif
\ No newline at end of file
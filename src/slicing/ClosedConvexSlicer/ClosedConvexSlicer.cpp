@@ -15,7 +15,22 @@ bool ClosedConvexSlicer::setSource( MFnMesh& source ) {
 	return (_inputModel.getVertices().size() != 0 && _inputModel.getIndices().size() != 0);
 }
 
+bool ClosedConvexSlicer::setSource( const Model& source ) {
+	_inputModel = source;
+	_inputModel.buildExtendedData();
+	return (_inputModel.getVertices().size() != 0 && _inputModel.getIndices().size() != 0);
+}
+
 bool ClosedConvexSlicer::slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh ) {
+	Model outModel;
+	if( !slice(cell, outModel) ) {
+		return false;
+	}
+	MayaHelper::copyModelToMFnMesh(outModel, outMesh, static_cast<float>(info.smoothingAngle));
+	return true;
+}
+
+bool ClosedConvexSlicer::slice( const Cell& cell, Model& outModel ) {
 	ClipMesh clipMesh(_inputModel);
 
 	// cut the ClipMesh with all planes of the cell
@@ -28,13 +43,16 @@ bool ClosedConvexSlicer::slice( const Cell& cell, const MeshSlicerInfo& info, MF
 	}
 	// if any cuts were successful, return converted model
 	if( anyResult ) {
-		Model outModel;
-		if( !clipMesh.convert(&outModel) ) {
-			return false;
-		}
-		MayaHelper::copyModelToMFnMesh(outModel, outMesh, static_cast<float>(info.smoothingAngle));
-		return true;
+		return clipMesh.convert(&outModel);
 	} else {
 		return false;
 	}
+}
+
+bool ClosedConvexSlicer::needsCellPlanes() const {
+	return true;
+}
+
+bool ClosedConvexSlicer::needsCellFaces() const {
+	return false;
 }
\ No newline at end of file
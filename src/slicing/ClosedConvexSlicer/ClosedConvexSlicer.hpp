@@ -10,7 +10,11 @@ public:
 	virtual ~ClosedConvexSlicer();
 
 	virtual bool setSource( MFnMesh& source ) override;
+	virtual bool setSource( const Model& source ) override;
 	virtual bool slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh ) override;
+	virtual bool slice( const Cell& cell, Model& outModel ) override;
+	virtual bool needsCellPlanes() const override;
+	virtual bool needsCellFaces() const override;
 
 private:
 	Model _inputModel;
@@ -3,6 +3,7 @@
 
 #include <cells/Cell.hpp>
 #include <maya/MFnMesh.h>
+#include <Model.hpp>
 #include "MeshSlicerInfo.hpp"
 
 class IMeshSlicer {
@@ -19,6 +20,13 @@ public:
 	 */
 	virtual bool setSource( MFnMesh& source )=0;
 
+	/**
+	 * Sets the source geometry from a Model, such as a chunk output by a previous slice.
+	 * @param[in] source Model source.  Must be closed.
+	 * @returns True upon success; false otherwise.
+	 */
+	virtual bool setSource( const Model& source )=0;
+
 	/**
 	 * Slices using a Cell.
 	 * @param[in]  cell    Cell that controls the slicing region.
@@ -27,6 +35,26 @@ public:
 	 * @returns True upon success; false otherwise.
 	 */
 	virtual bool slice( const Cell& cell, const MeshSlicerInfo& info, MFnMesh& outMesh )=0;
+
+	/**
+	 * Slices using a Cell without creating anything in Maya.
+	 * @param[in]  cell     Cell that controls the slicing region.
+	 * @param[out] outModel Output sliced Model.  Must be empty.
+	 * @returns True upon success; false otherwise.
+	 */
+	virtual bool slice( const Cell& cell, Model& outModel )=0;
+
+	/**
+	 * Whether slice reads the Cell's planes.
+	 * @returns True if Cells given to this slicer must have planes; false otherwise.
+	 */
+	virtual bool needsCellPlanes() const=0;
+
+	/**
+	 * Whether slice reads the Cell's vertices and faces.
+	 * @returns True if Cells given to this slicer must have faces; false otherwise.
+	 */
+	virtual bool needsCellFaces() const=0;
 };
 
 #endif /* __imeshslicer__ */
\ No newline at end of file